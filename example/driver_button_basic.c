@@ -59,6 +59,50 @@ uint8_t button_basic_irq_handler(uint8_t press_release)
     }
 }
 
+/**
+ * @brief     basic irq at a given time
+ * @param[in] press_release press or release
+ * @param[in] us timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      press is 1
+ *            release is 0
+ *            us must come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_basic_irq_handler_at(uint8_t press_release, uint64_t us)
+{
+    if (button_irq_handler_at(&gs_handle, press_release, us) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief     basic feed edges
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the edges must be in time order and come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_basic_feed_edges(const button_edge_t *edges, uint16_t len)
+{
+    if (button_feed_edges(&gs_handle, edges, len) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 /**
  * @brief  basic period
  * @return status code
@@ -76,6 +120,59 @@ uint8_t button_basic_period_handler(void)
     return 0;
 }
 
+/**
+ * @brief      basic next deadline
+ * @param[out] *us pointer to a deadline buffer
+ * @param[out] *hold pointer to a hold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       BUTTON_DEADLINE_NEVER means idle,
+ *             hold is 1 when a long press is held, then the host runs the period handler at its own hold period
+ */
+uint8_t button_basic_get_next_deadline(uint64_t *us, uint8_t *hold)
+{
+    button_state_t state;
+    
+    if (button_get_next_deadline_us(&gs_handle, us) != 0)
+    {
+        return 1;
+    }
+    if (button_get_state(&gs_handle, &state) != 0)
+    {
+        return 1;
+    }
+    
+    /* the hold deadline stays in the past while the press is held */
+    *hold = 0;
+    if ((state == BUTTON_STATE_LONG_HELD) && (*us != BUTTON_DEADLINE_NEVER))
+    {
+        *us = BUTTON_DEADLINE_NEVER;
+        *hold = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  basic log drain
+ * @return status code
+ *         - 0 success
+ *         - 1 drain failed
+ * @note   call it from a low priority context, nothing is printed when BUTTON_ENABLE_LOG is 0
+ */
+uint8_t button_basic_log_drain(void)
+{
+#if (BUTTON_ENABLE_LOG == 1)
+    if (button_log_drain(&gs_handle) != 0)
+    {
+        return 1;
+    }
+#endif
+    
+    return 0;
+}
+
 /**
  * @brief     basic example init
  * @param[in] *callback pointer to an irq callback address
@@ -91,6 +188,7 @@ uint8_t button_basic_init(void (*callback)(button_t *data))
     /* link interface function */
     DRIVER_BUTTON_LINK_INIT(&gs_handle, button_handle_t);
     DRIVER_BUTTON_LINK_TIMESTAMP_READ(&gs_handle, button_interface_timestamp_read);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ_US(&gs_handle, button_interface_timestamp_read_us);
     DRIVER_BUTTON_LINK_DELAY_MS(&gs_handle, button_interface_delay_ms);
     DRIVER_BUTTON_LINK_DEBUG_PRINT(&gs_handle, button_interface_debug_print);
     DRIVER_BUTTON_LINK_RECEIVE_CALLBACK(&gs_handle, callback);
@@ -104,6 +202,7 @@ uint8_t button_basic_init(void (*callback)(button_t *data))
         return 1;
     }
     
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
     /* set default timeout */
     res = button_set_timeout(&gs_handle, BUTTON_BASIC_DEFAULT_TIMEOUT);
     if (res != 0)
@@ -113,6 +212,7 @@ uint8_t button_basic_init(void (*callback)(button_t *data))
         
         return 1;
     }
+#endif
     
     /* set default interval */
     res = button_set_interval(&gs_handle, BUTTON_BASIC_DEFAULT_INTERVAL);
@@ -134,6 +234,7 @@ uint8_t button_basic_init(void (*callback)(button_t *data))
         return 1;
     }
     
+#if (BUTTON_ENABLE_LONG_PRESS == 1)
     /* set default long time */
     res = button_set_long_time(&gs_handle, BUTTON_BASIC_DEFAULT_LONG_TIME);
     if (res != 0)
@@ -143,7 +244,9 @@ uint8_t button_basic_init(void (*callback)(button_t *data))
         
         return 1;
     }
+#endif
     
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
     /* set default repeat time */
     res = button_set_repeat_time(&gs_handle, BUTTON_BASIC_DEFAULT_REPEAT_TIME);
     if (res != 0)
@@ -153,6 +256,7 @@ uint8_t button_basic_init(void (*callback)(button_t *data))
         
         return 1;
     }
+#endif
     
     return 0;
 }
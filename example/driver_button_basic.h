@@ -70,6 +70,30 @@ extern "C"{
  */
 uint8_t button_basic_irq_handler(uint8_t press_release);
 
+/**
+ * @brief     basic irq at a given time
+ * @param[in] press_release press or release
+ * @param[in] us timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      press is 1
+ *            release is 0
+ *            us must come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_basic_irq_handler_at(uint8_t press_release, uint64_t us);
+
+/**
+ * @brief     basic feed edges
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the edges must be in time order and come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_basic_feed_edges(const button_edge_t *edges, uint16_t len);
+
 /**
  * @brief  basic period
  * @return status code
@@ -79,6 +103,27 @@ uint8_t button_basic_irq_handler(uint8_t press_release);
  */
 uint8_t button_basic_period_handler(void);
 
+/**
+ * @brief      basic next deadline
+ * @param[out] *us pointer to a deadline buffer
+ * @param[out] *hold pointer to a hold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       BUTTON_DEADLINE_NEVER means idle,
+ *             hold is 1 when a long press is held, then the host runs the period handler at its own hold period
+ */
+uint8_t button_basic_get_next_deadline(uint64_t *us, uint8_t *hold);
+
+/**
+ * @brief  basic log drain
+ * @return status code
+ *         - 0 success
+ *         - 1 drain failed
+ * @note   call it from a low priority context, nothing is printed when BUTTON_ENABLE_LOG is 0
+ */
+uint8_t button_basic_log_drain(void);
+
 /**
  * @brief     basic example init
  * @param[in] *callback pointer to an irq callback address
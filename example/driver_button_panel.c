@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_button_panel.c
+ * @brief     driver button panel source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_button_panel.h"
+
+static button_handle_t gs_handle[BUTTON_PANEL_MAX];        /**< button handles */
+static button_group_t gs_group;                            /**< button group */
+static uint16_t gs_len;                                    /**< button number */
+
+/**
+ * @brief     panel irq at a given time
+ * @param[in] index button index
+ * @param[in] press_release press or release
+ * @param[in] us timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      press is 1
+ *            release is 0
+ *            us must come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_panel_irq_handler_at(uint16_t index, uint8_t press_release, uint64_t us)
+{
+    if (button_group_irq_handler_at(&gs_group, index, press_release, us) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief     panel feed edges
+ * @param[in] index button index
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the edges must be in time order and come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_panel_feed_edges(uint16_t index, const button_edge_t *edges, uint16_t len)
+{
+    if (button_group_feed_edges(&gs_group, index, edges, len) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief  panel period
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   only the buttons with a pending decision are served
+ */
+uint8_t button_panel_period_handler(void)
+{
+    if (button_group_period_handler(&gs_group) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      panel next deadline
+ * @param[out] *us pointer to a deadline buffer
+ * @param[out] *hold pointer to a hold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       BUTTON_DEADLINE_NEVER means no decision is pending,
+ *             hold is 1 when a long press is held, then the host runs the period handler at its own hold period,
+ *             the deadline of a held button is left out, so it does not delay the other buttons
+ */
+uint8_t button_panel_get_next_deadline(uint64_t *us, uint8_t *hold)
+{
+    uint16_t i;
+    uint64_t deadline;
+    button_state_t state;
+    
+    *us = BUTTON_DEADLINE_NEVER;
+    *hold = 0;
+    
+    /* find the earliest deadline that is not a hold */
+    for (i = 0; i < gs_len; i++)
+    {
+        if (button_get_next_deadline_us(&gs_handle[i], &deadline) != 0)
+        {
+            return 1;
+        }
+        if (button_get_state(&gs_handle[i], &state) != 0)
+        {
+            return 1;
+        }
+        if ((state == BUTTON_STATE_LONG_HELD) && (deadline != BUTTON_DEADLINE_NEVER))
+        {
+            *hold = 1;
+        }
+        else if (deadline < *us)
+        {
+            *us = deadline;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     init one panel button
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] *callback pointer to an irq callback address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_panel_button_init(button_handle_t *handle, void (*callback)(button_t *data))
+{
+    uint8_t res;
+    
+    /* link interface function */
+    DRIVER_BUTTON_LINK_INIT(handle, button_handle_t);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ(handle, button_interface_timestamp_read);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ_US(handle, button_interface_timestamp_read_us);
+    DRIVER_BUTTON_LINK_DELAY_MS(handle, button_interface_delay_ms);
+    DRIVER_BUTTON_LINK_DEBUG_PRINT(handle, button_interface_debug_print);
+    DRIVER_BUTTON_LINK_RECEIVE_CALLBACK(handle, callback);
+    
+    /* init */
+    res = button_init(handle);
+    if (res != 0)
+    {
+        button_interface_debug_print("button: init failed.\n");
+       
+        return 1;
+    }
+    
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+    /* set default timeout */
+    res = button_set_timeout(handle, BUTTON_PANEL_DEFAULT_TIMEOUT);
+    if (res != 0)
+    {
+        button_interface_debug_print("button: set timeout failed.\n");
+        (void)button_deinit(handle);
+        
+        return 1;
+    }
+#endif
+    
+    /* set default interval */
+    res = button_set_interval(handle, BUTTON_PANEL_DEFAULT_INTERVAL);
+    if (res != 0)
+    {
+        button_interface_debug_print("button: set interval failed.\n");
+        (void)button_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set default short time */
+    res = button_set_short_time(handle, BUTTON_PANEL_DEFAULT_SHORT_TIME);
+    if (res != 0)
+    {
+        button_interface_debug_print("button: set short time failed.\n");
+        (void)button_deinit(handle);
+        
+        return 1;
+    }
+    
+#if (BUTTON_ENABLE_LONG_PRESS == 1)
+    /* set default long time */
+    res = button_set_long_time(handle, BUTTON_PANEL_DEFAULT_LONG_TIME);
+    if (res != 0)
+    {
+        button_interface_debug_print("button: set long time failed.\n");
+        (void)button_deinit(handle);
+        
+        return 1;
+    }
+#endif
+    
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+    /* set default repeat time */
+    res = button_set_repeat_time(handle, BUTTON_PANEL_DEFAULT_REPEAT_TIME);
+    if (res != 0)
+    {
+        button_interface_debug_print("button: set repeat time failed.\n");
+        (void)button_deinit(handle);
+        
+        return 1;
+    }
+#endif
+    
+    return 0;
+}
+
+/**
+ * @brief     panel example init
+ * @param[in] len button number
+ * @param[in] *callback pointer to an irq callback address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      all buttons share the callback and one button group,
+ *            len must not be over BUTTON_PANEL_MAX
+ */
+uint8_t button_panel_init(uint16_t len, void (*callback)(button_t *data))
+{
+    uint16_t i;
+    uint16_t index;
+    
+    /* check the button number */
+    if ((len == 0) || (len > BUTTON_PANEL_MAX))
+    {
+        button_interface_debug_print("button: button number is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* init the group */
+    if (button_group_init(&gs_group) != 0)
+    {
+        button_interface_debug_print("button: group init failed.\n");
+        
+        return 1;
+    }
+    
+    /* init and add all buttons */
+    for (i = 0; i < len; i++)
+    {
+        if (a_panel_button_init(&gs_handle[i], callback) != 0)
+        {
+            gs_len = i;
+            (void)button_panel_deinit();
+            
+            return 1;
+        }
+        if (button_group_add(&gs_group, &gs_handle[i], &index) != 0)
+        {
+            button_interface_debug_print("button: group add failed.\n");
+            gs_len = i + 1;
+            (void)button_panel_deinit();
+            
+            return 1;
+        }
+    }
+    gs_len = len;
+    
+    return 0;
+}
+
+/**
+ * @brief  panel example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t button_panel_deinit(void)
+{
+    uint8_t res;
+    uint16_t i;
+    
+    res = 0;
+    for (i = 0; i < gs_len; i++)
+    {
+        if (button_deinit(&gs_handle[i]) != 0)
+        {
+            res = 1;
+        }
+    }
+    gs_len = 0;
+    if (button_group_deinit(&gs_group) != 0)
+    {
+        res = 1;
+    }
+    
+    return res;
+}
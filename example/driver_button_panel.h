@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_button_panel.h
+ * @brief     driver button panel header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BUTTON_PANEL_H
+#define DRIVER_BUTTON_PANEL_H
+
+#include "driver_button_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup button_example_driver
+ * @{
+ */
+
+/**
+ * @brief button panel example default definition
+ */
+#define BUTTON_PANEL_MAX                             8                         /**< max button number */
+#define BUTTON_PANEL_DEFAULT_TIMEOUT                 1000 * 1000               /**< 1s */
+#define BUTTON_PANEL_DEFAULT_INTERVAL                5 * 1000                  /**< 5ms */
+#define BUTTON_PANEL_DEFAULT_SHORT_TIME              1000 * 1000               /**< 1s */
+#define BUTTON_PANEL_DEFAULT_LONG_TIME               3 * 1000 * 1000           /**< 3s */
+#define BUTTON_PANEL_DEFAULT_REPEAT_TIME             200 * 1000                /**< 200ms */
+
+/**
+ * @brief     panel irq at a given time
+ * @param[in] index button index
+ * @param[in] press_release press or release
+ * @param[in] us timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      press is 1
+ *            release is 0
+ *            us must come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_panel_irq_handler_at(uint16_t index, uint8_t press_release, uint64_t us);
+
+/**
+ * @brief     panel feed edges
+ * @param[in] index button index
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the edges must be in time order and come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_panel_feed_edges(uint16_t index, const button_edge_t *edges, uint16_t len);
+
+/**
+ * @brief  panel period
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   only the buttons with a pending decision are served
+ */
+uint8_t button_panel_period_handler(void);
+
+/**
+ * @brief      panel next deadline
+ * @param[out] *us pointer to a deadline buffer
+ * @param[out] *hold pointer to a hold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       BUTTON_DEADLINE_NEVER means no decision is pending,
+ *             hold is 1 when a long press is held, then the host runs the period handler at its own hold period,
+ *             the deadline of a held button is left out, so it does not delay the other buttons
+ */
+uint8_t button_panel_get_next_deadline(uint64_t *us, uint8_t *hold);
+
+/**
+ * @brief     panel example init
+ * @param[in] len button number
+ * @param[in] *callback pointer to an irq callback address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      all buttons share the callback and one button group,
+ *            len must not be over BUTTON_PANEL_MAX
+ */
+uint8_t button_panel_init(uint16_t len, void (*callback)(button_t *data));
+
+/**
+ * @brief  panel example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t button_panel_deinit(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -60,6 +60,16 @@ extern "C"{
  */
 uint8_t button_interface_timestamp_read(button_time_t *t);
 
+/**
+ * @brief      interface timestamp read us
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the timestamp must be monotonic
+ */
+uint8_t button_interface_timestamp_read_us(uint64_t *us);
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -49,6 +49,19 @@ uint8_t button_interface_timestamp_read(button_time_t *t)
     return 0;
 }
 
+/**
+ * @brief      interface timestamp read us
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the timestamp must be monotonic
+ */
+uint8_t button_interface_timestamp_read_us(uint64_t *us)
+{
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      host_driver_button_interface.c
+ * @brief     host driver button interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_button_interface.h"
+#include "vclock.h"
+#include <stdarg.h>
+
+/**
+ * @brief     interface timestamp read
+ * @param[in] *t pointer to a button_time structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      the virtual clock is used
+ */
+uint8_t button_interface_timestamp_read(button_time_t *t)
+{
+    uint64_t us;
+    
+    us = vclock_get_us();
+    t->s = us / 1000000;
+    t->us = (uint32_t)(us % 1000000);
+    
+    return 0;
+}
+
+/**
+ * @brief      interface timestamp read us
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the virtual clock is used
+ */
+uint8_t button_interface_timestamp_read_us(uint64_t *us)
+{
+    *us = vclock_get_us();
+    
+    return 0;
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      the virtual clock is advanced
+ */
+void button_interface_delay_ms(uint32_t ms)
+{
+    vclock_advance_us((uint64_t)ms * 1000);
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void button_interface_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    (void)printf("%s", str);
+}
+
+/**
+ * @brief     interface receive callback
+ * @param[in] *data pointer to an button_t structure
+ * @note      none
+ */
+void button_interface_receive_callback(button_t *data)
+{
+    (void)printf("button: status 0x%04X times %d.\n", data->status, data->times);
+}
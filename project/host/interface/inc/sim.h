@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sim.h
+ * @brief     simulation harness header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include "driver_button_interface.h"
+#include "vclock.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup sim sim function
+ * @brief    simulation harness modules
+ * @{
+ */
+
+/**
+ * @brief simulation definition
+ */
+#define SIM_PERIOD_US        (10 * 1000)        /**< 10ms period */
+#define SIM_EVENT_MAX        256                /**< max recorded events */
+
+/**
+ * @brief simulation case structure definition
+ */
+typedef struct sim_case_s
+{
+    const char *name;                /**< case name */
+    uint8_t (*run)(void);            /**< case function */
+} sim_case_t;
+
+/**
+ * @brief simulation var definition
+ */
+extern button_handle_t g_sim_handle;                  /**< button handle */
+extern button_t g_sim_event[SIM_EVENT_MAX];           /**< recorded events */
+extern uint16_t g_sim_event_len;                      /**< recorded event number */
+extern uint8_t g_sim_irq_res;                         /**< last failed irq result */
+extern uint8_t g_sim_period_res;                      /**< last failed period result */
+
+/**
+ * @brief     record an event
+ * @param[in] *buf pointer to an event buffer
+ * @param[in] *len pointer to an event number
+ * @param[in] *data pointer to an button_t structure
+ * @note      consecutive long press holds are recorded once
+ */
+void sim_record(button_t *buf, uint16_t *len, button_t *data);
+
+/**
+ * @brief     receive callback
+ * @param[in] *data pointer to an button_t structure
+ * @note      the events of g_sim_handle are recorded in g_sim_event
+ */
+void sim_receive_callback(button_t *data);
+
+/**
+ * @brief     irq
+ * @param[in] press_release press or release
+ * @return    status code
+ * @note      a failed result is saved in g_sim_irq_res
+ */
+uint8_t sim_irq(uint8_t press_release);
+
+/**
+ * @brief  period
+ * @return status code
+ * @note   a failed result is saved in g_sim_period_res
+ */
+uint8_t sim_period(void);
+
+/**
+ * @brief     init a button
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] *callback pointer to a receive callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t sim_init(button_handle_t *handle, void (*callback)(button_t *data));
+
+/**
+ * @brief     check the recorded events
+ * @param[in] *buf pointer to the recorded events
+ * @param[in] len recorded event number
+ * @param[in] *expect pointer to the expected events
+ * @param[in] expect_len expected event number
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      times is only compared for the click events
+ */
+uint8_t sim_check(const button_t *buf, uint16_t len, const button_t *expect, uint16_t expect_len);
+
+/**
+ * @brief  reset the simulation
+ * @note   the virtual time restarts and the recorded events and results are cleared
+ */
+void sim_reset(void);
+
+/**
+ * @brief     run a click script
+ * @param[in] *edges pointer to an edge script
+ * @param[in] len edge number
+ * @param[in] end script length in us
+ * @param[in] *expect pointer to the expected events
+ * @param[in] expect_len expected event number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the script runs on g_sim_handle, the decoder must have no pending decision at the end
+ */
+uint8_t sim_script(const vclock_edge_t *edges, uint16_t len, uint64_t end, 
+                   const button_t *expect, uint16_t expect_len);
+
+/**
+ * @brief     run the simulation cases
+ * @param[in] *cases pointer to a case table
+ * @param[in] len case number
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      without args all cases are run, otherwise only the named cases,
+ *            a name that matches no case fails the run
+ */
+int sim_run(const sim_case_t *cases, int len, int argc, char **argv);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
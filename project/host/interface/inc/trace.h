@@ -0,0 +1,233 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      trace.h
+ * @brief     trace header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup trace trace function
+ * @brief    edge trace function modules
+ * @{
+ */
+
+/**
+ * @brief trace format definition
+ * @note  a trace is the header "BTRC", one version byte and the start time as a varint,
+ *        followed by one varint per record, the varint is (delta << 2) | kind,
+ *        delta is the time in us since the previous record or the start time,
+ *        a finished trace ends with the block index, 16 bytes {t, offset} per block in little endian,
+ *        then the block number as 8 bytes and the index magic "BTRI"
+ */
+#define TRACE_MAGIC            "BTRC"        /**< trace magic */
+#define TRACE_INDEX_MAGIC      "BTRI"        /**< index magic */
+#define TRACE_VERSION          2             /**< trace version */
+#define TRACE_HEADER_MAX       15            /**< max header length */
+#define TRACE_RECORD_MAX       10            /**< max record length */
+#define TRACE_INDEX_ENTRY      16            /**< index entry length */
+#define TRACE_INDEX_TRAILER    12            /**< index trailer length */
+#define TRACE_BLOCK_RECORDS    1024          /**< records per block */
+
+/**
+ * @brief trace kind enumeration definition
+ */
+typedef enum
+{
+    TRACE_KIND_RELEASE = 0x00,        /**< release edge */
+    TRACE_KIND_PRESS   = 0x01,        /**< press edge */
+    TRACE_KIND_TICK    = 0x02,        /**< period tick */
+} trace_kind_t;
+
+/**
+ * @brief trace record structure definition
+ */
+typedef struct trace_record_s
+{
+    uint64_t t;             /**< timestamp in us */
+    uint8_t kind;           /**< record kind */
+} trace_record_t;
+
+/**
+ * @brief trace block structure definition
+ */
+typedef struct trace_block_s
+{
+    uint64_t t;             /**< timestamp before the first record in us */
+    uint64_t offset;        /**< file offset of the first record */
+} trace_block_t;
+
+/**
+ * @brief trace writer structure definition
+ */
+typedef struct trace_writer_s
+{
+    uint8_t *buf;           /**< output buffer */
+    size_t cap;             /**< buffer size */
+    size_t len;             /**< used length */
+    uint64_t last;          /**< last timestamp */
+    uint64_t offset;        /**< file offset of buf[0] */
+    uint32_t count;         /**< records in the current block */
+    trace_block_t *block;   /**< block index buffer */
+    uint32_t block_cap;     /**< block index size */
+    uint32_t block_len;     /**< indexed block number */
+    uint32_t block_pos;     /**< written index entries */
+} trace_writer_t;
+
+/**
+ * @brief trace reader structure definition
+ */
+typedef struct trace_reader_s
+{
+    const uint8_t *buf;     /**< input buffer */
+    size_t len;             /**< buffer length */
+    size_t pos;             /**< read position */
+    uint64_t last;          /**< last timestamp */
+    const uint8_t *index;   /**< block index, NULL means no index */
+    uint64_t block_len;     /**< indexed block number */
+} trace_reader_t;
+
+/**
+ * @brief     init a trace writer and write the header
+ * @param[in] *writer pointer to a trace writer structure
+ * @param[in] *buf pointer to an output buffer
+ * @param[in] cap buffer size
+ * @param[in] start start time in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 writer is NULL
+ *            - 5 buffer is full
+ * @note      none
+ */
+uint8_t trace_writer_init(trace_writer_t *writer, uint8_t *buf, size_t cap, uint64_t start);
+
+/**
+ * @brief     append a record
+ * @param[in] *writer pointer to a trace writer structure
+ * @param[in] kind record kind
+ * @param[in] t timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 writer is NULL
+ *            - 4 timestamp is not monotonic or kind is invalid
+ *            - 5 buffer is full
+ * @note      when 5 is returned, store buf[0, len), call trace_writer_reset and put the record again
+ */
+uint8_t trace_writer_put(trace_writer_t *writer, uint8_t kind, uint64_t t);
+
+/**
+ * @brief     set the block index buffer
+ * @param[in] *writer pointer to a trace writer structure
+ * @param[in] *block pointer to a block index buffer
+ * @param[in] cap block index size
+ * @return    status code
+ *            - 0 success
+ *            - 2 writer is NULL
+ * @note      call it before the first record, a block starts every TRACE_BLOCK_RECORDS records,
+ *            the blocks after a full index are not indexed and a seek falls back on the last indexed one
+ */
+uint8_t trace_writer_set_index(trace_writer_t *writer, trace_block_t *block, uint32_t cap);
+
+/**
+ * @brief     append the block index
+ * @param[in] *writer pointer to a trace writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 writer is NULL
+ *            - 5 buffer is full
+ * @note      when 5 is returned, store buf[0, len), call trace_writer_reset and finish again,
+ *            no record can be put after it
+ */
+uint8_t trace_writer_finish(trace_writer_t *writer);
+
+/**
+ * @brief     empty the output buffer
+ * @param[in] *writer pointer to a trace writer structure
+ * @note      the delta base is kept, so the next bytes continue the same trace
+ */
+void trace_writer_reset(trace_writer_t *writer);
+
+/**
+ * @brief     init a trace reader and parse the header
+ * @param[in] *reader pointer to a trace reader structure
+ * @param[in] *buf pointer to a trace buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 reader is NULL
+ *            - 4 header is invalid
+ * @note      the buffer is decoded in place, a valid block index at its end is used for seeking
+ */
+uint8_t trace_reader_init(trace_reader_t *reader, const uint8_t *buf, size_t len);
+
+/**
+ * @brief      read the next record
+ * @param[in]  *reader pointer to a trace reader structure
+ * @param[out] *record pointer to a trace record structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 end of trace
+ *             - 4 record is invalid
+ * @note       none
+ */
+uint8_t trace_reader_next(trace_reader_t *reader, trace_record_t *record);
+
+/**
+ * @brief     seek to the block holding a time
+ * @param[in] *reader pointer to a trace reader structure
+ * @param[in] t timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 reader is NULL
+ * @note      the next record is the first one of the last block starting before t,
+ *            so no record at or after t is skipped, a trace without index restarts from the beginning
+ */
+uint8_t trace_reader_seek(trace_reader_t *reader, uint64_t t);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
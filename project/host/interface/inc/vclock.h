@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      vclock.h
+ * @brief     virtual clock header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef VCLOCK_H
+#define VCLOCK_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup vclock vclock function
+ * @brief    virtual clock function modules
+ * @{
+ */
+
+/**
+ * @brief vclock edge structure definition
+ */
+typedef struct vclock_edge_s
+{
+    uint64_t t;             /**< time from the start of the script in us */
+    uint8_t level;          /**< press is 1, release is 0 */
+} vclock_edge_t;
+
+/**
+ * @brief     set the virtual time
+ * @param[in] us time in us
+ * @note      none
+ */
+void vclock_set_us(uint64_t us);
+
+/**
+ * @brief  get the virtual time
+ * @return time in us
+ * @note   none
+ */
+uint64_t vclock_get_us(void);
+
+/**
+ * @brief     advance the virtual time
+ * @param[in] us time in us
+ * @note      none
+ */
+void vclock_advance_us(uint64_t us);
+
+/**
+ * @brief     run a scripted edge source
+ * @param[in] *edges pointer to an edge script
+ * @param[in] len edge number
+ * @param[in] end script length in us
+ * @param[in] period period in us
+ * @param[in] *irq pointer to an irq function, the edge time is the current virtual time
+ * @param[in] *period_irq pointer to a period function
+ * @note      the script starts at the current virtual time,
+ *            the period function runs every period us and before an edge at the same time,
+ *            a NULL function is skipped
+ */
+void vclock_run(const vclock_edge_t *edges, uint16_t len, uint64_t end, uint32_t period,
+                uint8_t (*irq)(uint8_t press_release), uint8_t (*period_irq)(void));
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
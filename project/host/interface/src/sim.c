@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sim.c
+ * @brief     simulation harness source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sim.h"
+
+/**
+ * @brief global var definition
+ */
+button_handle_t g_sim_handle;                  /**< button handle */
+button_t g_sim_event[SIM_EVENT_MAX];           /**< recorded events */
+uint16_t g_sim_event_len;                      /**< recorded event number */
+uint8_t g_sim_irq_res;                         /**< last failed irq result */
+uint8_t g_sim_period_res;                      /**< last failed period result */
+
+/**
+ * @brief     record an event
+ * @param[in] *buf pointer to an event buffer
+ * @param[in] *len pointer to an event number
+ * @param[in] *data pointer to an button_t structure
+ * @note      consecutive long press holds are recorded once
+ */
+void sim_record(button_t *buf, uint16_t *len, button_t *data)
+{
+    if ((data->status == BUTTON_STATUS_LONG_PRESS_HOLD) && (*len != 0) && 
+        (buf[*len - 1].status == BUTTON_STATUS_LONG_PRESS_HOLD))
+    {
+        return;
+    }
+    if (*len < SIM_EVENT_MAX)
+    {
+        buf[*len] = *data;
+        (*len)++;
+    }
+}
+
+/**
+ * @brief     receive callback
+ * @param[in] *data pointer to an button_t structure
+ * @note      the events of g_sim_handle are recorded in g_sim_event
+ */
+void sim_receive_callback(button_t *data)
+{
+    sim_record(g_sim_event, &g_sim_event_len, data);
+}
+
+/**
+ * @brief     irq
+ * @param[in] press_release press or release
+ * @return    status code
+ * @note      a failed result is saved in g_sim_irq_res
+ */
+uint8_t sim_irq(uint8_t press_release)
+{
+    uint8_t res;
+    
+    res = button_irq_handler(&g_sim_handle, press_release);
+    if (res != 0)
+    {
+        g_sim_irq_res = res;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief  period
+ * @return status code
+ * @note   a failed result is saved in g_sim_period_res
+ */
+uint8_t sim_period(void)
+{
+    uint8_t res;
+    
+    res = button_period_handler(&g_sim_handle);
+    if (res != 0)
+    {
+        g_sim_period_res = res;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     init a button
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] *callback pointer to a receive callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t sim_init(button_handle_t *handle, void (*callback)(button_t *data))
+{
+    DRIVER_BUTTON_LINK_INIT(handle, button_handle_t);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ(handle, button_interface_timestamp_read);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ_US(handle, button_interface_timestamp_read_us);
+    DRIVER_BUTTON_LINK_DELAY_MS(handle, button_interface_delay_ms);
+    DRIVER_BUTTON_LINK_DEBUG_PRINT(handle, button_interface_debug_print);
+    DRIVER_BUTTON_LINK_RECEIVE_CALLBACK(handle, callback);
+    if (button_init(handle) != 0)
+    {
+        button_interface_debug_print("sim: init failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the recorded events
+ * @param[in] *buf pointer to the recorded events
+ * @param[in] len recorded event number
+ * @param[in] *expect pointer to the expected events
+ * @param[in] expect_len expected event number
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      times is only compared for the click events
+ */
+uint8_t sim_check(const button_t *buf, uint16_t len, const button_t *expect, uint16_t expect_len)
+{
+    uint16_t i;
+    
+    if (len != expect_len)
+    {
+        button_interface_debug_print("sim: got %d events, expect %d.\n", len, expect_len);
+        
+        return 1;
+    }
+    for (i = 0; i < len; i++)
+    {
+        if ((buf[i].status != expect[i].status) || 
+            ((expect[i].times != 0) && (buf[i].times != expect[i].times)))
+        {
+            button_interface_debug_print("sim: event %d is 0x%04X x%d, expect 0x%04X x%d.\n", i,
+                                         buf[i].status, buf[i].times, expect[i].status, expect[i].times);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  reset the simulation
+ * @note   the virtual time restarts and the recorded events and results are cleared
+ */
+void sim_reset(void)
+{
+    vclock_set_us(1000000);
+    g_sim_event_len = 0;
+    g_sim_irq_res = 0;
+    g_sim_period_res = 0;
+}
+
+/**
+ * @brief     run a click script
+ * @param[in] *edges pointer to an edge script
+ * @param[in] len edge number
+ * @param[in] end script length in us
+ * @param[in] *expect pointer to the expected events
+ * @param[in] expect_len expected event number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the script runs on g_sim_handle, the decoder must have no pending decision at the end
+ */
+uint8_t sim_script(const vclock_edge_t *edges, uint16_t len, uint64_t end, 
+                   const button_t *expect, uint16_t expect_len)
+{
+    uint64_t deadline;
+    
+    sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    vclock_run(edges, len, end, SIM_PERIOD_US, sim_irq, sim_period);
+    if (sim_check(g_sim_event, g_sim_event_len, expect, expect_len) != 0)
+    {
+        return 1;
+    }
+    if ((g_sim_handle.state != BUTTON_STATE_IDLE) || 
+        (button_get_next_deadline_us(&g_sim_handle, &deadline) != 0) || 
+        (deadline != BUTTON_DEADLINE_NEVER))
+    {
+        button_interface_debug_print("sim: decoder is not idle.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the simulation cases
+ * @param[in] *cases pointer to a case table
+ * @param[in] len case number
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      without args all cases are run, otherwise only the named cases,
+ *            a name that matches no case fails the run
+ */
+int sim_run(const sim_case_t *cases, int len, int argc, char **argv)
+{
+    int i;
+    int j;
+    int failed;
+    int found;
+    
+    failed = 0;
+    for (j = 1; j < argc; j++)
+    {
+        for (i = 0; i < len; i++)
+        {
+            if (strcmp(argv[j], cases[i].name) == 0)
+            {
+                break;
+            }
+        }
+        if (i == len)
+        {
+            button_interface_debug_print("sim: %s is not a case.\n", argv[j]);
+            failed++;
+        }
+    }
+    for (i = 0; i < len; i++)
+    {
+        found = (argc == 1) ? 1 : 0;
+        for (j = 1; j < argc; j++)
+        {
+            if (strcmp(argv[j], cases[i].name) == 0)
+            {
+                found = 1;
+            }
+        }
+        if (found == 0)
+        {
+            continue;
+        }
+        if (cases[i].run() != 0)
+        {
+            button_interface_debug_print("sim: %s failed.\n", cases[i].name);
+            failed++;
+        }
+        else
+        {
+            button_interface_debug_print("sim: %s passed.\n", cases[i].name);
+        }
+    }
+    
+    return (failed != 0) ? 1 : 0;
+}
@@ -0,0 +1,456 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      trace.c
+ * @brief     trace source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "trace.h"
+#include <string.h>
+
+/**
+ * @brief     encode a varint
+ * @param[in] *buf pointer to an output buffer
+ * @param[in] v value
+ * @return    encoded length
+ * @note      the buffer must hold TRACE_RECORD_MAX bytes
+ */
+static size_t a_trace_varint_put(uint8_t *buf, uint64_t v)
+{
+    size_t i;
+    
+    i = 0;
+    while (v >= 0x80)
+    {
+        buf[i] = (uint8_t)(v | 0x80);
+        v >>= 7;
+        i++;
+    }
+    buf[i] = (uint8_t)v;
+    
+    return i + 1;
+}
+
+/**
+ * @brief      decode a varint
+ * @param[in]  *buf pointer to an input buffer
+ * @param[in]  len buffer length
+ * @param[out] *v pointer to a value buffer
+ * @return     decoded length, 0 means invalid or truncated
+ * @note       none
+ */
+static size_t a_trace_varint_get(const uint8_t *buf, size_t len, uint64_t *v)
+{
+    size_t i;
+    uint64_t r;
+    
+    r = 0;
+    for (i = 0; (i < len) && (i < TRACE_RECORD_MAX); i++)
+    {
+        r |= (uint64_t)(buf[i] & 0x7F) << (7 * i);
+        if ((buf[i] & 0x80) == 0)
+        {
+            *v = r;
+            
+            return i + 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     encode a little endian uint64
+ * @param[in] *buf pointer to an output buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_trace_u64_put(uint8_t *buf, uint64_t v)
+{
+    uint8_t i;
+    
+    for (i = 0; i < 8; i++)
+    {
+        buf[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+/**
+ * @brief     decode a little endian uint64
+ * @param[in] *buf pointer to an input buffer
+ * @return    value
+ * @note      none
+ */
+static uint64_t a_trace_u64_get(const uint8_t *buf)
+{
+    uint8_t i;
+    uint64_t v;
+    
+    v = 0;
+    for (i = 0; i < 8; i++)
+    {
+        v |= (uint64_t)buf[i] << (8 * i);
+    }
+    
+    return v;
+}
+
+/**
+ * @brief     init a trace writer and write the header
+ * @param[in] *writer pointer to a trace writer structure
+ * @param[in] *buf pointer to an output buffer
+ * @param[in] cap buffer size
+ * @param[in] start start time in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 writer is NULL
+ *            - 5 buffer is full
+ * @note      none
+ */
+uint8_t trace_writer_init(trace_writer_t *writer, uint8_t *buf, size_t cap, uint64_t start)
+{
+    if (writer == NULL)
+    {
+        return 2;
+    }
+    if (cap < TRACE_HEADER_MAX)
+    {
+        return 5;
+    }
+    
+    memcpy(buf, TRACE_MAGIC, 4);
+    buf[4] = TRACE_VERSION;
+    writer->buf = buf;
+    writer->cap = cap;
+    writer->len = 5 + a_trace_varint_put(&buf[5], start);
+    writer->last = start;
+    writer->offset = 0;
+    writer->count = 0;
+    writer->block = NULL;
+    writer->block_cap = 0;
+    writer->block_len = 0;
+    writer->block_pos = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     append a record
+ * @param[in] *writer pointer to a trace writer structure
+ * @param[in] kind record kind
+ * @param[in] t timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 writer is NULL
+ *            - 4 timestamp is not monotonic or kind is invalid
+ *            - 5 buffer is full
+ * @note      when 5 is returned, store buf[0, len), call trace_writer_reset and put the record again
+ */
+uint8_t trace_writer_put(trace_writer_t *writer, uint8_t kind, uint64_t t)
+{
+    uint64_t delta;
+    
+    if (writer == NULL)
+    {
+        return 2;
+    }
+    if ((kind > TRACE_KIND_TICK) || (t < writer->last))
+    {
+        return 4;
+    }
+    delta = t - writer->last;
+    if (delta > (0xFFFFFFFFFFFFFFFFULL >> 2))
+    {
+        return 4;
+    }
+    if (writer->cap - writer->len < TRACE_RECORD_MAX)
+    {
+        return 5;
+    }
+    
+    /* start a new block */
+    if (writer->count == TRACE_BLOCK_RECORDS)
+    {
+        if ((writer->block != NULL) && (writer->block_len < writer->block_cap))
+        {
+            writer->block[writer->block_len].t = writer->last;
+            writer->block[writer->block_len].offset = writer->offset + writer->len;
+            writer->block_len++;
+        }
+        writer->count = 0;
+    }
+    writer->count++;
+    writer->len += a_trace_varint_put(&writer->buf[writer->len], (delta << 2) | kind);
+    writer->last = t;
+    
+    return 0;
+}
+
+/**
+ * @brief     set the block index buffer
+ * @param[in] *writer pointer to a trace writer structure
+ * @param[in] *block pointer to a block index buffer
+ * @param[in] cap block index size
+ * @return    status code
+ *            - 0 success
+ *            - 2 writer is NULL
+ * @note      call it before the first record, a block starts every TRACE_BLOCK_RECORDS records,
+ *            the blocks after a full index are not indexed and a seek falls back on the last indexed one
+ */
+uint8_t trace_writer_set_index(trace_writer_t *writer, trace_block_t *block, uint32_t cap)
+{
+    if (writer == NULL)
+    {
+        return 2;
+    }
+    
+    writer->block = block;
+    writer->block_cap = (block != NULL) ? cap : 0;
+    writer->block_len = 0;
+    writer->block_pos = 0;
+    writer->count = 0;
+    if (writer->block_cap != 0)
+    {
+        block[0].t = writer->last;
+        block[0].offset = writer->offset + writer->len;
+        writer->block_len = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     append the block index
+ * @param[in] *writer pointer to a trace writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 writer is NULL
+ *            - 5 buffer is full
+ * @note      when 5 is returned, store buf[0, len), call trace_writer_reset and finish again,
+ *            no record can be put after it
+ */
+uint8_t trace_writer_finish(trace_writer_t *writer)
+{
+    if (writer == NULL)
+    {
+        return 2;
+    }
+    
+    /* write the entries left */
+    while (writer->block_pos < writer->block_len)
+    {
+        if (writer->cap - writer->len < TRACE_INDEX_ENTRY)
+        {
+            return 5;
+        }
+        a_trace_u64_put(&writer->buf[writer->len], writer->block[writer->block_pos].t);
+        a_trace_u64_put(&writer->buf[writer->len + 8], writer->block[writer->block_pos].offset);
+        writer->len += TRACE_INDEX_ENTRY;
+        writer->block_pos++;
+    }
+    
+    /* write the trailer once */
+    if (writer->block_pos == writer->block_len)
+    {
+        if (writer->cap - writer->len < TRACE_INDEX_TRAILER)
+        {
+            return 5;
+        }
+        a_trace_u64_put(&writer->buf[writer->len], writer->block_len);
+        memcpy(&writer->buf[writer->len + 8], TRACE_INDEX_MAGIC, 4);
+        writer->len += TRACE_INDEX_TRAILER;
+        writer->block_pos++;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     empty the output buffer
+ * @param[in] *writer pointer to a trace writer structure
+ * @note      the delta base is kept, so the next bytes continue the same trace
+ */
+void trace_writer_reset(trace_writer_t *writer)
+{
+    writer->offset += writer->len;
+    writer->len = 0;
+}
+
+/**
+ * @brief     init a trace reader and parse the header
+ * @param[in] *reader pointer to a trace reader structure
+ * @param[in] *buf pointer to a trace buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 reader is NULL
+ *            - 4 header is invalid
+ * @note      the buffer is decoded in place, a valid block index at its end is used for seeking
+ */
+uint8_t trace_reader_init(trace_reader_t *reader, const uint8_t *buf, size_t len)
+{
+    size_t n;
+    size_t end;
+    uint64_t i;
+    uint64_t blocks;
+    uint64_t offset;
+    
+    if (reader == NULL)
+    {
+        return 2;
+    }
+    if ((len < 6) || (memcmp(buf, TRACE_MAGIC, 4) != 0) || 
+        (buf[4] == 0) || (buf[4] > TRACE_VERSION))
+    {
+        return 4;
+    }
+    n = a_trace_varint_get(&buf[5], len - 5, &reader->last);
+    if (n == 0)
+    {
+        return 4;
+    }
+    
+    reader->buf = buf;
+    reader->len = len;
+    reader->pos = 5 + n;
+    reader->index = NULL;
+    reader->block_len = 0;
+    
+    /* use the block index of a finished trace */
+    if ((len - reader->pos < TRACE_INDEX_TRAILER) || 
+        (memcmp(&buf[len - 4], TRACE_INDEX_MAGIC, 4) != 0))
+    {
+        return 0;
+    }
+    blocks = a_trace_u64_get(&buf[len - TRACE_INDEX_TRAILER]);
+    if (blocks > (len - reader->pos - TRACE_INDEX_TRAILER) / TRACE_INDEX_ENTRY)
+    {
+        return 0;
+    }
+    end = len - TRACE_INDEX_TRAILER - (size_t)blocks * TRACE_INDEX_ENTRY;
+    for (i = 0; i < blocks; i++)
+    {
+        offset = a_trace_u64_get(&buf[end + i * TRACE_INDEX_ENTRY + 8]);
+        if ((offset < reader->pos) || (offset > end))
+        {
+            return 0;
+        }
+    }
+    reader->len = end;
+    reader->index = &buf[end];
+    reader->block_len = blocks;
+    
+    return 0;
+}
+
+/**
+ * @brief      read the next record
+ * @param[in]  *reader pointer to a trace reader structure
+ * @param[out] *record pointer to a trace record structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 end of trace
+ *             - 4 record is invalid
+ * @note       none
+ */
+uint8_t trace_reader_next(trace_reader_t *reader, trace_record_t *record)
+{
+    size_t n;
+    uint64_t v;
+    
+    if (reader->pos >= reader->len)
+    {
+        return 1;
+    }
+    n = a_trace_varint_get(&reader->buf[reader->pos], reader->len - reader->pos, &v);
+    if ((n == 0) || ((v & 3) > TRACE_KIND_TICK))
+    {
+        return 4;
+    }
+    
+    reader->pos += n;
+    reader->last += v >> 2;
+    record->t = reader->last;
+    record->kind = (uint8_t)(v & 3);
+    
+    return 0;
+}
+
+/**
+ * @brief     seek to the block holding a time
+ * @param[in] *reader pointer to a trace reader structure
+ * @param[in] t timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 reader is NULL
+ * @note      the next record is the first one of the last block starting before t,
+ *            so no record at or after t is skipped, a trace without index restarts from the beginning
+ */
+uint8_t trace_reader_seek(trace_reader_t *reader, uint64_t t)
+{
+    uint64_t lo;
+    uint64_t hi;
+    uint64_t mid;
+    
+    if (reader == NULL)
+    {
+        return 2;
+    }
+    
+    /* restart from the header without index */
+    if (reader->block_len == 0)
+    {
+        reader->pos = 5 + a_trace_varint_get(&reader->buf[5], reader->len - 5, &reader->last);
+        
+        return 0;
+    }
+    
+    /* find the last block starting before t */
+    lo = 0;
+    hi = reader->block_len;
+    while (hi - lo > 1)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (a_trace_u64_get(&reader->index[mid * TRACE_INDEX_ENTRY]) < t)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    reader->last = a_trace_u64_get(&reader->index[lo * TRACE_INDEX_ENTRY]);
+    reader->pos = (size_t)a_trace_u64_get(&reader->index[lo * TRACE_INDEX_ENTRY + 8]);
+    
+    return 0;
+}
@@ -0,0 +1,474 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bench.c
+ * @brief     bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_button_interface.h"
+#include "vclock.h"
+#include <stdlib.h>
+#include <time.h>
+#include <getopt.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_PERIOD_US         (10 * 1000)        /**< 10ms period */
+#define BENCH_SAMPLE_MAX        (1 << 20)          /**< max samples per handler */
+#define BENCH_EDGE_MAX          32                 /**< max edges per cycle */
+#define BENCH_DEFAULT_CYCLES    2000               /**< default cycles per workload */
+#define BENCH_STATE_NUM         9                  /**< decoder state number */
+#define BENCH_EVENT_NUM         4                  /**< press, release, timer and wait */
+#define BENCH_BRANCH_NUM        (BENCH_STATE_NUM * BENCH_EVENT_NUM)    /**< branch number */
+
+/**
+ * @brief bench workload structure definition
+ */
+typedef struct bench_workload_s
+{
+    const char *name;                       /**< workload name */
+    vclock_edge_t edge[BENCH_EDGE_MAX];     /**< edges of one cycle */
+    uint16_t len;                           /**< edge number */
+    uint64_t cycle;                         /**< cycle length in us */
+} bench_workload_t;
+
+/**
+ * @brief bench sample structure definition
+ */
+typedef struct bench_sample_s
+{
+    uint32_t *ns;               /**< sample buffer */
+    uint8_t *branch;            /**< branch of every sample */
+    uint32_t len;               /**< sample number */
+    uint64_t total;             /**< total ns */
+} bench_sample_t;
+
+/**
+ * @brief bench workload table
+ */
+static const bench_workload_t gs_workload[] =
+{
+    {"idle", {{0, 0}}, 0, 1000000},
+    {"single_click", {{100000, 1}, {200000, 0}}, 2, 600000},
+    {"repeat_click_8", {{100000, 1}, {150000, 0}, {200000, 1}, {250000, 0}, {300000, 1}, {350000, 0}, 
+                        {400000, 1}, {450000, 0}, {500000, 1}, {550000, 0}, {600000, 1}, {650000, 0}, 
+                        {700000, 1}, {750000, 0}, {800000, 1}, {850000, 0}}, 16, 1200000},
+    {"long_hold", {{100000, 1}, {4100000, 0}}, 2, 4500000},
+    {"bounce_storm", {{100000, 1}, {100500, 0}, {101000, 1}, {101500, 0}, {102000, 1}, {102500, 0}, 
+                      {103000, 1}, {103500, 0}, {104000, 1}, {104500, 0}, {105000, 1}, {105500, 0}, 
+                      {106000, 1}, {106500, 0}, {107000, 1}, {107500, 0}, {108000, 1}, {200000, 0}}, 18, 600000},
+};
+
+/**
+ * @brief bench state name table
+ */
+static const char *const gs_state_name[BENCH_STATE_NUM] =
+{
+    "idle", "pressed", "short_held", "long_held", "released_wait", 
+    "short_released", "long_released", "click_pressed", "clicking",
+};
+
+/**
+ * @brief bench event name table
+ */
+static const char *const gs_event_name[BENCH_EVENT_NUM] =
+{
+    "press", "release", "timer", "wait",
+};
+
+/**
+ * @brief global var definition
+ */
+static button_handle_t gs_handle;              /**< button handle */
+static bench_sample_t gs_irq;                  /**< irq samples */
+static bench_sample_t gs_period;               /**< period samples */
+static uint64_t gs_events;                     /**< decoded events */
+static uint32_t *gs_scratch;                   /**< samples of one branch */
+
+/**
+ * @brief  read the real time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_ns(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     save a sample
+ * @param[in] *sample pointer to a sample structure
+ * @param[in] ns sample in ns
+ * @param[in] state decoder state before the call
+ * @param[in] event press, release, timer or wait
+ * @note      none
+ */
+static void a_bench_save(bench_sample_t *sample, uint64_t ns, uint8_t state, uint8_t event)
+{
+    if (sample->len < BENCH_SAMPLE_MAX)
+    {
+        sample->ns[sample->len] = (ns > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32_t)ns;
+        sample->branch[sample->len] = (uint8_t)(state * BENCH_EVENT_NUM + event);
+        sample->len++;
+    }
+    sample->total += ns;
+}
+
+/**
+ * @brief     receive callback
+ * @param[in] *data pointer to an button_t structure
+ * @note      none
+ */
+static void a_bench_receive_callback(button_t *data)
+{
+    (void)data;
+    gs_events++;
+}
+
+/**
+ * @brief     silent print
+ * @param[in] fmt format data
+ * @note      the decoder errors of the bounce storm are expected
+ */
+static void a_bench_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     measured irq
+ * @param[in] press_release press or release
+ * @return    status code
+ * @note      the sample is kept under the state before the call and the edge
+ */
+static uint8_t a_bench_irq(uint8_t press_release)
+{
+    uint8_t res;
+    uint8_t state;
+    uint64_t start;
+    uint64_t stop;
+    
+    state = gs_handle.state;
+    start = a_bench_ns();
+    res = button_irq_handler(&gs_handle, press_release);
+    stop = a_bench_ns();
+    a_bench_save(&gs_irq, stop - start, state, (press_release != 0) ? 0 : 1);
+    
+    return res;
+}
+
+/**
+ * @brief  measured period
+ * @return status code
+ * @note   the sample is kept under the state before the call, a call that reports nothing and
+ *         keeps the state is a wait, any other call is a timer transition
+ */
+static uint8_t a_bench_period(void)
+{
+    uint8_t res;
+    uint8_t state;
+    uint64_t events;
+    uint64_t start;
+    uint64_t stop;
+    
+    state = gs_handle.state;
+    events = gs_events;
+    start = a_bench_ns();
+    res = button_period_handler(&gs_handle);
+    stop = a_bench_ns();
+    a_bench_save(&gs_period, stop - start, state, 
+                 ((gs_handle.state == state) && (gs_events == events)) ? 3 : 2);
+    
+    return res;
+}
+
+/**
+ * @brief     compare two samples
+ * @param[in] *a pointer to a sample
+ * @param[in] *b pointer to a sample
+ * @return    compare result
+ * @note      none
+ */
+static int a_bench_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief     print one sample line
+ * @param[in] *workload pointer to a workload name
+ * @param[in] *handler pointer to a handler name
+ * @param[in] *branch pointer to a branch name
+ * @param[in] *ns pointer to a sample buffer
+ * @param[in] len sample number
+ * @param[in] total total ns
+ * @return    mean ns per call
+ * @note      the samples are sorted in place
+ */
+static double a_bench_print(const char *workload, const char *handler, const char *branch, 
+                            uint32_t *ns, uint32_t len, uint64_t total)
+{
+    double mean;
+    
+    qsort(ns, len, sizeof(uint32_t), a_bench_compare);
+    mean = (double)total / (double)len;
+    printf("%-16s %-8s %-24s %10u %10.1f %8u %8u %8u\n", workload, handler, branch, len, mean,
+           ns[len / 2], ns[(uint32_t)(((uint64_t)len * 99) / 100)], ns[len - 1]);
+    
+    return mean;
+}
+
+/**
+ * @brief     print the samples
+ * @param[in] *workload pointer to a workload name
+ * @param[in] *handler pointer to a handler name
+ * @param[in] *sample pointer to a sample structure
+ * @return    mean ns per call
+ * @note      the handler line is followed by one line per decoder branch
+ */
+static double a_bench_report(const char *workload, const char *handler, bench_sample_t *sample)
+{
+    char name[32];
+    uint8_t b;
+    uint32_t i;
+    uint32_t len;
+    uint64_t total;
+    double mean;
+    
+    if (sample->len == 0)
+    {
+        return 0.0;
+    }
+    
+    /* split the samples by branch before the handler samples are sorted */
+    for (b = 0; b < BENCH_BRANCH_NUM; b++)
+    {
+        len = 0;
+        total = 0;
+        for (i = 0; i < sample->len; i++)
+        {
+            if (sample->branch[i] == b)
+            {
+                gs_scratch[len] = sample->ns[i];
+                total += sample->ns[i];
+                len++;
+            }
+        }
+        if (len == 0)
+        {
+            continue;
+        }
+        (void)snprintf(name, sizeof(name), "%s/%s", gs_state_name[b / BENCH_EVENT_NUM], 
+                       gs_event_name[b % BENCH_EVENT_NUM]);
+        (void)a_bench_print(workload, handler, name, gs_scratch, len, total);
+    }
+    mean = a_bench_print(workload, handler, "all", sample->ns, sample->len, sample->total);
+    
+    return mean;
+}
+
+/**
+ * @brief     run a workload
+ * @param[in] *workload pointer to a workload structure
+ * @param[in] cycles cycle number
+ * @param[in] limit mean ns limit, 0 means no limit
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_bench_run(const bench_workload_t *workload, uint32_t cycles, double limit)
+{
+    uint8_t res;
+    uint32_t i;
+    double mean;
+    double eps;
+    
+    /* init the button */
+    DRIVER_BUTTON_LINK_INIT(&gs_handle, button_handle_t);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ(&gs_handle, button_interface_timestamp_read);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ_US(&gs_handle, button_interface_timestamp_read_us);
+    DRIVER_BUTTON_LINK_DELAY_MS(&gs_handle, button_interface_delay_ms);
+    DRIVER_BUTTON_LINK_DEBUG_PRINT(&gs_handle, a_bench_debug_print);
+    DRIVER_BUTTON_LINK_RECEIVE_CALLBACK(&gs_handle, a_bench_receive_callback);
+    vclock_set_us(1000000);
+    if (button_init(&gs_handle) != 0)
+    {
+        printf("bench: init failed.\n");
+        
+        return 1;
+    }
+    gs_irq.len = 0;
+    gs_irq.total = 0;
+    gs_period.len = 0;
+    gs_period.total = 0;
+    gs_events = 0;
+    
+    /* run all cycles */
+    for (i = 0; i < cycles; i++)
+    {
+        vclock_run(workload->edge, workload->len, workload->cycle, BENCH_PERIOD_US, a_bench_irq, a_bench_period);
+    }
+    (void)button_deinit(&gs_handle);
+    
+    /* report */
+    res = 0;
+    mean = a_bench_report(workload->name, "irq", &gs_irq);
+    if ((limit > 0.0) && (mean > limit))
+    {
+        res = 1;
+    }
+    mean = a_bench_report(workload->name, "period", &gs_period);
+    if ((limit > 0.0) && (mean > limit))
+    {
+        res = 1;
+    }
+    eps = (gs_irq.total + gs_period.total != 0) ? 
+          (double)gs_events * 1e9 / (double)(gs_irq.total + gs_period.total) : 0.0;
+    printf("%-16s %-8s %-24s %10llu events %.0f events/s\n", workload->name, "all", "all", 
+           (unsigned long long)gs_events, eps);
+    
+    return res;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed or a limit is exceeded
+ * @note      button_bench [-n cycles] [-l mean_ns_limit] [workload ...]
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int i;
+    int j;
+    int found;
+    int failed;
+    uint32_t cycles;
+    double limit;
+    
+    /* parse the args */
+    cycles = BENCH_DEFAULT_CYCLES;
+    limit = 0.0;
+    while ((c = getopt(argc, argv, "n:l:h")) != -1)
+    {
+        switch (c)
+        {
+            case 'n' :
+            {
+                cycles = (uint32_t)strtoul(optarg, NULL, 0);
+                
+                break;
+            }
+            case 'l' :
+            {
+                limit = strtod(optarg, NULL);
+                
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  button_bench [-n cycles] [-l mean_ns_limit] [workload ...]\n");
+                printf("\n");
+                printf("Workloads:\n");
+                for (i = 0; i < (int)(sizeof(gs_workload) / sizeof(bench_workload_t)); i++)
+                {
+                    printf("  %s\n", gs_workload[i].name);
+                }
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    }
+    
+    /* alloc the samples */
+    gs_irq.ns = (uint32_t *)malloc(sizeof(uint32_t) * BENCH_SAMPLE_MAX);
+    gs_irq.branch = (uint8_t *)malloc(sizeof(uint8_t) * BENCH_SAMPLE_MAX);
+    gs_period.ns = (uint32_t *)malloc(sizeof(uint32_t) * BENCH_SAMPLE_MAX);
+    gs_period.branch = (uint8_t *)malloc(sizeof(uint8_t) * BENCH_SAMPLE_MAX);
+    gs_scratch = (uint32_t *)malloc(sizeof(uint32_t) * BENCH_SAMPLE_MAX);
+    if ((gs_irq.ns == NULL) || (gs_irq.branch == NULL) || (gs_period.ns == NULL) || 
+        (gs_period.branch == NULL) || (gs_scratch == NULL))
+    {
+        printf("bench: malloc failed.\n");
+        free(gs_irq.ns);
+        free(gs_irq.branch);
+        free(gs_period.ns);
+        free(gs_period.branch);
+        free(gs_scratch);
+        
+        return 1;
+    }
+    
+    /* run the workloads */
+    failed = 0;
+    printf("%-16s %-8s %-24s %10s %10s %8s %8s %8s\n", "workload", "handler", "branch", 
+           "calls", "ns/call", "p50", "p99", "max");
+    for (i = 0; i < (int)(sizeof(gs_workload) / sizeof(bench_workload_t)); i++)
+    {
+        found = (optind >= argc) ? 1 : 0;
+        for (j = optind; j < argc; j++)
+        {
+            if (strcmp(argv[j], gs_workload[i].name) == 0)
+            {
+                found = 1;
+            }
+        }
+        if (found == 0)
+        {
+            continue;
+        }
+        if (a_bench_run(&gs_workload[i], cycles, limit) != 0)
+        {
+            failed++;
+        }
+    }
+    free(gs_irq.ns);
+    free(gs_irq.branch);
+    free(gs_period.ns);
+    free(gs_period.branch);
+    free(gs_scratch);
+    
+    return (failed != 0) ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      lite.c
+ * @brief     lite main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sim.h"
+
+/**
+ * @brief  single click case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the click is reported with the release, the script ends one period later
+ */
+static uint8_t a_sim_single_click(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}};
+    
+    return sim_script(edges, 2, 200000 + SIM_PERIOD_US, expect, 3);
+}
+
+/**
+ * @brief  double tap case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   without the multi click decoding every tap is a single click
+ */
+static uint8_t a_sim_double_tap(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}, {300000, 1}, {400000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}};
+    
+    return sim_script(edges, 4, 1000000, expect, 6);
+}
+
+/**
+ * @brief  short press case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the short press is not reported
+ */
+static uint8_t a_sim_short_press(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {1600000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}};
+    
+    return sim_script(edges, 2, 2000000, expect, 2);
+}
+
+/**
+ * @brief  long press case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the long press hold is not reported
+ */
+static uint8_t a_sim_long_press(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {5100000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_LONG_PRESS_START, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_LONG_PRESS_END, 0}};
+    
+    return sim_script(edges, 2, 6000000, expect, 4);
+}
+
+/**
+ * @brief simulation case table
+ */
+static const sim_case_t gs_case[] =
+{
+    {"single_click", a_sim_single_click},
+    {"double_tap", a_sim_double_tap},
+    {"short_press", a_sim_short_press},
+    {"long_press", a_sim_long_press},
+};
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      without args all cases are run, otherwise only the named cases
+ */
+int main(int argc, char **argv)
+{
+    return sim_run(gs_case, (int)(sizeof(gs_case) / sizeof(sim_case_t)), argc, argv);
+}
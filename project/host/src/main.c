@@ -0,0 +1,1162 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sim.h"
+#include <stdlib.h>
+
+/**
+ * @brief global var definition
+ */
+static button_handle_t gs_handle2;                    /**< second button handle */
+static button_group_t gs_group;                       /**< button group */
+static button_t gs_event2[SIM_EVENT_MAX];             /**< recorded events of the second button */
+static uint16_t gs_event2_len;                        /**< recorded event number of the second button */
+static uint16_t gs_batch_calls;                       /**< batch callback calls */
+
+/**
+ * @brief     second receive callback
+ * @param[in] *data pointer to an button_t structure
+ * @note      none
+ */
+static void a_sim_receive_callback2(button_t *data)
+{
+    sim_record(gs_event2, &gs_event2_len, data);
+}
+
+/**
+ * @brief     batch receive callback
+ * @param[in] *data pointer to an button_t buffer
+ * @param[in] len event number
+ * @note      none
+ */
+static void a_sim_receive_callback_batch(button_t *data, uint16_t len)
+{
+    uint16_t i;
+    
+    gs_batch_calls++;
+    for (i = 0; i < len; i++)
+    {
+        sim_record(g_sim_event, &g_sim_event_len, &data[i]);
+    }
+}
+
+/**
+ * @brief     capture irq
+ * @param[in] press_release press or release
+ * @return    status code
+ * @note      none
+ */
+static uint8_t a_sim_capture_irq(uint8_t press_release)
+{
+    uint8_t res;
+    
+    res = button_irq_capture_handler(&g_sim_handle, press_release);
+    if (res != 0)
+    {
+        g_sim_irq_res = res;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief  group period
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sim_group_period(void)
+{
+    uint8_t res;
+    
+    res = button_group_period_handler(&gs_group);
+    if (res != 0)
+    {
+        g_sim_period_res = res;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief  reset the simulation
+ * @note   none
+ */
+static void a_sim_reset(void)
+{
+    sim_reset();
+    gs_event2_len = 0;
+    gs_batch_calls = 0;
+}
+
+/**
+ * @brief  single click case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_single_click(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}};
+    
+    return sim_script(edges, 2, 1000000, expect, 3);
+}
+
+/**
+ * @brief  double click case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_double_click(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}, {300000, 1}, {400000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_DOUBLE_CLICK, 2}};
+    
+    return sim_script(edges, 4, 1000000, expect, 5);
+}
+
+/**
+ * @brief  triple click case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_triple_click(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}, {300000, 1}, {400000, 0}, 
+                                   {500000, 1}, {600000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_TRIPLE_CLICK, 3}};
+    
+    return sim_script(edges, 6, 1000000, expect, 7);
+}
+
+/**
+ * @brief  repeat click case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_repeat_click(void)
+{
+    uint16_t i;
+    vclock_edge_t edges[16];
+    button_t expect[17];
+    
+    for (i = 0; i < 8; i++)
+    {
+        edges[i * 2].t = 100000 + i * 100000;
+        edges[i * 2].level = 1;
+        edges[i * 2 + 1].t = 150000 + i * 100000;
+        edges[i * 2 + 1].level = 0;
+        expect[i * 2].status = BUTTON_STATUS_PRESS;
+        expect[i * 2].times = 0;
+        expect[i * 2 + 1].status = BUTTON_STATUS_RELEASE;
+        expect[i * 2 + 1].times = 0;
+    }
+    expect[16].status = BUTTON_STATUS_REPEAT_CLICK;
+    expect[16].times = 8;
+    
+    return sim_script(edges, 16, 2000000, expect, 17);
+}
+
+/**
+ * @brief  short press case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_short_press(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {1600000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_SHORT_PRESS_END, 0}};
+    
+    return sim_script(edges, 2, 2000000, expect, 4);
+}
+
+/**
+ * @brief  long press case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_long_press(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {3400000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                               {BUTTON_STATUS_LONG_PRESS_START, 0}, {BUTTON_STATUS_LONG_PRESS_HOLD, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_LONG_PRESS_END, 0}};
+    
+    return sim_script(edges, 2, 4000000, expect, 6);
+}
+
+/**
+ * @brief  bounce case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_bounce(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {101000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}};
+    
+    if (sim_script(edges, 2, 1000000, expect, 1) != 0)
+    {
+        return 1;
+    }
+    if (g_sim_irq_res != 5)
+    {
+        button_interface_debug_print("sim: irq result is %d, expect 5.\n", g_sim_irq_res);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  timeout case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_timeout(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}, {300000, 1}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}};
+    
+    if (sim_script(edges, 3, 2000000, expect, 3) != 0)
+    {
+        return 1;
+    }
+    if (g_sim_period_res != 4)
+    {
+        button_interface_debug_print("sim: period result is %d, expect 4.\n", g_sim_period_res);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  click gap case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the period is run once at the end, so the click that ends in the slow gap is reported
+ *         by the next press as a ticking decoder reports it
+ */
+static uint8_t a_sim_click_gap(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}, {500000, 1}, {600000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}};
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    vclock_run(edges, 4, 1000000, 0, sim_irq, NULL);
+    if ((g_sim_irq_res != 0) || (sim_period() != 0))
+    {
+        button_interface_debug_print("sim: irq result is %d, period result is %d, expect 0.\n", 
+                                     g_sim_irq_res, g_sim_period_res);
+        
+        return 1;
+    }
+    
+    return sim_check(g_sim_event, g_sim_event_len, expect, 6);
+}
+
+/**
+ * @brief  immediate click case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the first click is checked one period after its release, long before the repeat time
+ */
+static uint8_t a_sim_immediate_click(void)
+{
+    const vclock_edge_t click[] = {{100000, 1}, {200000, 0}};
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}, {300000, 1}, {1800000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_SHORT_PRESS_END, 0}};
+    button_click_mode_t mode;
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    if (button_set_click_mode(&g_sim_handle, BUTTON_CLICK_MODE_IMMEDIATE) != 0)
+    {
+        return 1;
+    }
+    if ((button_get_click_mode(&g_sim_handle, &mode) != 0) || (mode != BUTTON_CLICK_MODE_IMMEDIATE))
+    {
+        button_interface_debug_print("sim: click mode is not immediate.\n");
+        
+        return 1;
+    }
+    vclock_run(click, 2, 200000 + SIM_PERIOD_US, SIM_PERIOD_US, sim_irq, sim_period);
+    if (sim_check(g_sim_event, g_sim_event_len, expect, 3) != 0)
+    {
+        return 1;
+    }
+    vclock_run(edges, 4, 2500000, SIM_PERIOD_US, sim_irq, sim_period);
+    if (sim_check(g_sim_event, g_sim_event_len, expect, 10) != 0)
+    {
+        return 1;
+    }
+    if (g_sim_handle.state != BUTTON_STATE_IDLE)
+    {
+        button_interface_debug_print("sim: decoder is not idle.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  immediate late case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the period runs once after a press longer than the short time is released,
+ *         the press is a short press and not an immediate click
+ */
+static uint8_t a_sim_immediate_late(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {1150000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_SHORT_PRESS_END, 0}};
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    if (button_set_click_mode(&g_sim_handle, BUTTON_CLICK_MODE_IMMEDIATE) != 0)
+    {
+        return 1;
+    }
+    vclock_run(edges, 2, 1200000, 0, sim_irq, NULL);
+    if ((g_sim_irq_res != 0) || (sim_period() != 0))
+    {
+        button_interface_debug_print("sim: irq result is %d, period result is %d, expect 0.\n", 
+                                     g_sim_irq_res, g_sim_period_res);
+        
+        return 1;
+    }
+    if (sim_check(g_sim_event, g_sim_event_len, expect, 4) != 0)
+    {
+        return 1;
+    }
+    if (g_sim_handle.state != BUTTON_STATE_IDLE)
+    {
+        button_interface_debug_print("sim: decoder is not idle.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  speculative click case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   a single click is confirmed, a double and a triple click supersede it,
+ *         the click held into the timeout is confirmed by the reset
+ */
+static uint8_t a_sim_speculative_click(void)
+{
+#if (BUTTON_ENABLE_STATS == 1)
+    button_stats_t stats;
+#endif
+    const vclock_edge_t click[] = {{100000, 1}, {200000, 0}};
+    const vclock_edge_t edges[] = {{500000, 1}, {600000, 0}, {700000, 1}, {800000, 0}, 
+                                   {1500000, 1}, {1600000, 0}, {1700000, 1}, {1800000, 0}, {1900000, 1}, {2000000, 0}, 
+                                   {2500000, 1}, {2600000, 0}, {2700000, 1}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK | BUTTON_STATUS_FLAG_PROVISIONAL, 1}, 
+                               {BUTTON_STATUS_SINGLE_CLICK | BUTTON_STATUS_FLAG_CONFIRM, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK | BUTTON_STATUS_FLAG_PROVISIONAL, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_DOUBLE_CLICK | BUTTON_STATUS_FLAG_SUPERSEDES, 2}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK | BUTTON_STATUS_FLAG_PROVISIONAL, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_TRIPLE_CLICK | BUTTON_STATUS_FLAG_SUPERSEDES, 3}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK | BUTTON_STATUS_FLAG_PROVISIONAL, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK | BUTTON_STATUS_FLAG_CONFIRM, 1}};
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    if (button_set_click_mode(&g_sim_handle, BUTTON_CLICK_MODE_SPECULATIVE) != 0)
+    {
+        return 1;
+    }
+    vclock_run(click, 2, 200000 + SIM_PERIOD_US, SIM_PERIOD_US, sim_irq, sim_period);
+    if (sim_check(g_sim_event, g_sim_event_len, expect, 3) != 0)
+    {
+        return 1;
+    }
+    vclock_run(edges, 13, 4500000, SIM_PERIOD_US, sim_irq, sim_period);
+    if (sim_check(g_sim_event, g_sim_event_len, expect, 23) != 0)
+    {
+        return 1;
+    }
+    if (g_sim_period_res != 4)
+    {
+        button_interface_debug_print("sim: period result is %d, expect 4.\n", g_sim_period_res);
+        
+        return 1;
+    }
+#if (BUTTON_ENABLE_STATS == 1)
+    
+    /* a provisional click is counted once it resolves */
+    if ((button_get_stats(&g_sim_handle, &stats) != 0) || (stats.event[2] != 2) || 
+        (stats.event[3] != 1) || (stats.event[4] != 1))
+    {
+        button_interface_debug_print("sim: single click count is %u, expect 2.\n", stats.event[2]);
+        
+        return 1;
+    }
+#endif
+    
+    return 0;
+}
+
+/**
+ * @brief  not monotonic case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   an edge older than a late period reset is still newer than the last edge
+ */
+static uint8_t a_sim_not_monotonic(void)
+{
+    uint8_t res;
+    uint64_t t;
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    t = vclock_get_us();
+    if (button_irq_handler_at(&g_sim_handle, 1, t + 100000) != 0)
+    {
+        return 1;
+    }
+    res = button_irq_handler_at(&g_sim_handle, 0, t + 50000);
+    if (res != 6)
+    {
+        button_interface_debug_print("sim: irq result is %d, expect 6.\n", res);
+        
+        return 1;
+    }
+    if (g_sim_handle.state != BUTTON_STATE_IDLE)
+    {
+        button_interface_debug_print("sim: decoder is not idle.\n");
+        
+        return 1;
+    }
+    if ((button_irq_handler_at(&g_sim_handle, 1, t + 200000) != 0) || 
+        (button_irq_handler_at(&g_sim_handle, 0, t + 300000) != 0) || 
+        (button_period_handler_at(&g_sim_handle, t + 900000) != 0))
+    {
+        return 1;
+    }
+    res = button_irq_handler_at(&g_sim_handle, 1, t + 600000);
+    if (res != 0)
+    {
+        button_interface_debug_print("sim: edge after a late period reset returns %d, expect 0.\n", res);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  capture case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_capture(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}, {300000, 1}, {400000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_DOUBLE_CLICK, 2}};
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    vclock_run(edges, 4, 1000000, SIM_PERIOD_US, a_sim_capture_irq, sim_period);
+    
+    return sim_check(g_sim_event, g_sim_event_len, expect, 5);
+}
+
+/**
+ * @brief  late capture drain case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   a captured edge is due at once for a tickless host, and the short press decision between
+ *         two captured edges is run at its deadline when the queue is drained late
+ */
+static uint8_t a_sim_capture_late(void)
+{
+    uint64_t t;
+    uint64_t deadline;
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_SHORT_PRESS_END, 0}};
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    vclock_advance_us(100000);
+    t = vclock_get_us();
+    (void)a_sim_capture_irq(1);
+    if ((button_get_next_deadline_us(&g_sim_handle, &deadline) != 0) || (deadline != t))
+    {
+        button_interface_debug_print("sim: captured edge is not due.\n");
+        
+        return 1;
+    }
+    vclock_advance_us(1500000);
+    (void)a_sim_capture_irq(0);
+    vclock_advance_us(100000);
+    if (sim_period() != 0)
+    {
+        button_interface_debug_print("sim: period result is %d, expect 0.\n", g_sim_period_res);
+        
+        return 1;
+    }
+    if ((button_get_next_deadline_us(&g_sim_handle, &deadline) != 0) || (deadline != BUTTON_DEADLINE_NEVER))
+    {
+        button_interface_debug_print("sim: decoder is not idle.\n");
+        
+        return 1;
+    }
+    
+    return sim_check(g_sim_event, g_sim_event_len, expect, 4);
+}
+
+/**
+ * @brief  feed edges case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_feed_edges(void)
+{
+    uint16_t i;
+    uint64_t t;
+    button_edge_t edges[6];
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_DOUBLE_CLICK, 2}};
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    t = vclock_get_us();
+    for (i = 0; i < 6; i++)
+    {
+        edges[i].t = t + 100000 + i * 100000 + ((i >= 2) ? 500000 : 0);
+        edges[i].level = ((i % 2) == 0) ? 1 : 0;
+    }
+    vclock_set_us(edges[5].t);
+    if (button_feed_edges(&g_sim_handle, edges, 6) != 0)
+    {
+        return 1;
+    }
+    vclock_run(NULL, 0, 1000000, SIM_PERIOD_US, NULL, sim_period);
+    
+    return sim_check(g_sim_event, g_sim_event_len, expect, 8);
+}
+
+/**
+ * @brief  feed same case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   one edge list is decoded edge by edge and as one array without a period in between,
+ *         both must report the gestures a ticking decoder reports
+ */
+static uint8_t a_sim_feed_same(void)
+{
+    uint8_t res;
+    uint16_t i;
+    uint64_t t;
+    button_edge_t edges[12];
+    const uint32_t offset[12] = {100000, 1100003, 1500000, 1600000, 1700000, 1800000, 
+                                 2500000, 5600000, 6000000, 6100000, 6500000, 6600000};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_SHORT_PRESS_END, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_DOUBLE_CLICK, 2}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                               {BUTTON_STATUS_LONG_PRESS_START, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_LONG_PRESS_END, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}};
+    
+    a_sim_reset();
+    if ((sim_init(&g_sim_handle, sim_receive_callback) != 0) || 
+        (sim_init(&gs_handle2, a_sim_receive_callback2) != 0))
+    {
+        return 1;
+    }
+    t = vclock_get_us();
+    for (i = 0; i < 12; i++)
+    {
+        edges[i].t = t + offset[i];
+        edges[i].level = ((i % 2) == 0) ? 1 : 0;
+    }
+    res = 0;
+    for (i = 0; i < 12; i++)
+    {
+        res |= button_irq_handler_at(&g_sim_handle, edges[i].level, edges[i].t);
+    }
+    res |= button_feed_edges(&gs_handle2, edges, 12);
+    res |= button_period_handler_at(&g_sim_handle, t + 8000000);
+    res |= button_period_handler_at(&gs_handle2, t + 8000000);
+    if (res != 0)
+    {
+        button_interface_debug_print("sim: decode failed.\n");
+        
+        return 1;
+    }
+    if (sim_check(g_sim_event, g_sim_event_len, expect, 20) != 0)
+    {
+        return 1;
+    }
+    
+    return sim_check(gs_event2, gs_event2_len, g_sim_event, g_sim_event_len);
+}
+
+/**
+ * @brief  deadline case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_deadline(void)
+{
+    uint64_t t;
+    uint64_t deadline;
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, sim_receive_callback) != 0)
+    {
+        return 1;
+    }
+    (void)button_get_next_deadline_us(&g_sim_handle, &deadline);
+    if (deadline != BUTTON_DEADLINE_NEVER)
+    {
+        button_interface_debug_print("sim: idle deadline is not never.\n");
+        
+        return 1;
+    }
+    vclock_advance_us(100000);
+    t = vclock_get_us();
+    (void)sim_irq(1);
+    (void)button_get_next_deadline_us(&g_sim_handle, &deadline);
+    if (deadline != t + g_sim_handle.short_time)
+    {
+        button_interface_debug_print("sim: press deadline is wrong.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  pull case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   41 events are decoded into a queue of BUTTON_EVENT_LENGTH
+ */
+static uint8_t a_sim_pull(void)
+{
+    uint8_t res;
+    uint16_t i;
+    uint16_t len;
+    uint32_t dropped;
+    vclock_edge_t edges[40];
+    button_t buf[BUTTON_EVENT_LENGTH];
+    
+    a_sim_reset();
+    if (sim_init(&g_sim_handle, NULL) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < 40; i++)
+    {
+        edges[i].t = 100000 + i * 20000;
+        edges[i].level = ((i % 2) == 0) ? 1 : 0;
+    }
+    vclock_run(edges, 40, 2000000, SIM_PERIOD_US, sim_irq, sim_period);
+    res = button_read_events(&g_sim_handle, buf, BUTTON_EVENT_LENGTH, &len);
+    (void)button_get_event_dropped(&g_sim_handle, &dropped);
+    if ((res != 4) || (len != BUTTON_EVENT_LENGTH) || (dropped != 41 - BUTTON_EVENT_LENGTH))
+    {
+        button_interface_debug_print("sim: read %d events with %d, dropped %d.\n", len, res, dropped);
+        
+        return 1;
+    }
+    res = button_read_events(&g_sim_handle, buf, BUTTON_EVENT_LENGTH, &len);
+    if ((res != 0) || (len != 0))
+    {
+        button_interface_debug_print("sim: queue is not empty.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  batch case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_batch(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {1600000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                               {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_SHORT_PRESS_END, 0}};
+    
+    a_sim_reset();
+    DRIVER_BUTTON_LINK_INIT(&g_sim_handle, button_handle_t);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ(&g_sim_handle, button_interface_timestamp_read);
+    DRIVER_BUTTON_LINK_DELAY_MS(&g_sim_handle, button_interface_delay_ms);
+    DRIVER_BUTTON_LINK_DEBUG_PRINT(&g_sim_handle, button_interface_debug_print);
+    DRIVER_BUTTON_LINK_RECEIVE_CALLBACK_BATCH(&g_sim_handle, a_sim_receive_callback_batch);
+    if (button_init(&g_sim_handle) != 0)
+    {
+        return 1;
+    }
+    vclock_run(edges, 2, 2000000, SIM_PERIOD_US, sim_irq, sim_period);
+    if (gs_batch_calls != 4)
+    {
+        button_interface_debug_print("sim: %d batch calls, expect 4.\n", gs_batch_calls);
+        
+        return 1;
+    }
+    
+    return sim_check(g_sim_event, g_sim_event_len, expect, 4);
+}
+
+/**
+ * @brief  group case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_group(void)
+{
+    uint8_t res;
+    uint16_t index;
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}};
+    const button_t expect2[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_SHORT_PRESS_START, 0}, 
+                                {BUTTON_STATUS_RELEASE, 0}, {BUTTON_STATUS_SHORT_PRESS_END, 0}};
+    
+    a_sim_reset();
+    if ((sim_init(&g_sim_handle, sim_receive_callback) != 0) || 
+        (sim_init(&gs_handle2, a_sim_receive_callback2) != 0))
+    {
+        return 1;
+    }
+    (void)button_group_init(&gs_group);
+    (void)button_group_add(&gs_group, &g_sim_handle, &index);
+    (void)button_group_add(&gs_group, &gs_handle2, &index);
+    vclock_run(NULL, 0, 100000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    (void)button_group_irq_handler(&gs_group, 1, 1);
+    vclock_run(NULL, 0, 100000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    (void)button_group_irq_handler(&gs_group, 0, 1);
+    vclock_run(NULL, 0, 100000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    (void)button_group_irq_handler(&gs_group, 0, 0);
+    vclock_run(NULL, 0, 1500000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    (void)button_group_irq_handler(&gs_group, 1, 0);
+    vclock_run(NULL, 0, 500000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    if ((gs_group.active[0] != 0) || 
+        (sim_check(g_sim_event, g_sim_event_len, expect, 3) != 0) || 
+        (sim_check(gs_event2, gs_event2_len, expect2, 4) != 0))
+    {
+        return 1;
+    }
+    
+    /* the decoder result is passed through */
+    res = button_group_irq_handler_at(&gs_group, 0, 1, 0);
+    if (res != 6)
+    {
+        button_interface_debug_print("sim: group irq result is %d, expect 6.\n", res);
+        
+        return 1;
+    }
+    res = button_group_irq_handler(&gs_group, 2, 1);
+    if (res != 7)
+    {
+        button_interface_debug_print("sim: group irq result is %d, expect 7.\n", res);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  group capture case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the captured edges of a grouped button mark it active, so the group period handler decodes them
+ */
+static uint8_t a_sim_group_capture(void)
+{
+    uint16_t index;
+    uint64_t t;
+    uint64_t deadline;
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}};
+    
+    a_sim_reset();
+    if ((sim_init(&g_sim_handle, sim_receive_callback) != 0) || 
+        (sim_init(&gs_handle2, a_sim_receive_callback2) != 0))
+    {
+        return 1;
+    }
+    (void)button_group_init(&gs_group);
+    (void)button_group_add(&gs_group, &g_sim_handle, &index);
+    (void)button_group_add(&gs_group, &gs_handle2, &index);
+    vclock_run(NULL, 0, 100000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    t = vclock_get_us();
+    (void)button_group_irq_capture_handler(&gs_group, 1, 1);
+    if ((button_group_get_next_deadline_us(&gs_group, &deadline) != 0) || (deadline != t))
+    {
+        button_interface_debug_print("sim: captured edge is not due.\n");
+        
+        return 1;
+    }
+    vclock_advance_us(100000);
+    (void)button_group_irq_capture_handler(&gs_group, 1, 0);
+    vclock_run(NULL, 0, 1000000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    if ((gs_group.active[0] != 0) || (g_sim_event_len != 0) || 
+        (sim_check(gs_event2, gs_event2_len, expect, 3) != 0))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  group feed case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   a burst fed to a grouped button marks it active, so the group period handler ends the click
+ */
+static uint8_t a_sim_group_feed(void)
+{
+    uint8_t res;
+    uint16_t index;
+    uint64_t t;
+    button_edge_t edges[2];
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_SINGLE_CLICK, 1}};
+    
+    a_sim_reset();
+    if ((sim_init(&g_sim_handle, sim_receive_callback) != 0) || 
+        (sim_init(&gs_handle2, a_sim_receive_callback2) != 0))
+    {
+        return 1;
+    }
+    (void)button_group_init(&gs_group);
+    (void)button_group_add(&gs_group, &g_sim_handle, &index);
+    (void)button_group_add(&gs_group, &gs_handle2, &index);
+    vclock_run(NULL, 0, 100000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    t = vclock_get_us();
+    edges[0].t = t;
+    edges[0].level = 1;
+    edges[1].t = t + 100000;
+    edges[1].level = 0;
+    vclock_advance_us(100000);
+    res = button_group_feed_edges(&gs_group, 1, edges, 2);
+    if ((res != 0) || (gs_group.active[0] != 2))
+    {
+        button_interface_debug_print("sim: group feed result is %d, active is 0x%08X.\n", res, gs_group.active[0]);
+        
+        return 1;
+    }
+    vclock_run(NULL, 0, 1000000, SIM_PERIOD_US, NULL, a_sim_group_period);
+    if ((gs_group.active[0] != 0) || (g_sim_event_len != 0) || 
+        (sim_check(gs_event2, gs_event2_len, expect, 3) != 0))
+    {
+        return 1;
+    }
+    if (button_group_feed_edges(&gs_group, 2, edges, 2) != 7)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+#if (BUTTON_ENABLE_STATS == 1)
+/**
+ * @brief  statistics case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_stats(void)
+{
+    const vclock_edge_t edges[] = {{100000, 1}, {200000, 0}, {300000, 1}, {400000, 0}};
+    const vclock_edge_t bounce[] = {{100000, 1}, {101000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0}, 
+                               {BUTTON_STATUS_PRESS, 0}, {BUTTON_STATUS_RELEASE, 0},
+                               {BUTTON_STATUS_DOUBLE_CLICK, 2}};
+    button_stats_t stats;
+    
+    /* a double click and a bounce on the same handle */
+    if (sim_script(edges, 4, 1000000, expect, 5) != 0)
+    {
+        return 1;
+    }
+    vclock_run(bounce, 2, 1000000, SIM_PERIOD_US, sim_irq, sim_period);
+    if (button_get_stats(&g_sim_handle, &stats) != 0)
+    {
+        return 1;
+    }
+    if ((stats.edge_accepted != 5) || (stats.edge_rejected != 1) || 
+        (stats.reset[BUTTON_RESET_TOO_FAST] != 1) || (stats.reset[BUTTON_RESET_DOUBLE_PRESS] != 0) ||
+        (stats.event[0] != 3) || (stats.event[1] != 2) || (stats.event[3] != 1) || (stats.decode_max != 4))
+    {
+        button_interface_debug_print("sim: stats are %d accepted, %d rejected, %d too fast, %d max depth.\n",
+                                     stats.edge_accepted, stats.edge_rejected, 
+                                     stats.reset[BUTTON_RESET_TOO_FAST], stats.decode_max);
+        
+        return 1;
+    }
+    
+    /* reset the statistics */
+    if (button_reset_stats(&g_sim_handle) != 0)
+    {
+        return 1;
+    }
+    if ((button_get_stats(&g_sim_handle, &stats) != 0) || (stats.edge_accepted != 0) || (stats.event[0] != 0))
+    {
+        button_interface_debug_print("sim: stats are not reset.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+#endif
+
+#if (BUTTON_ENABLE_LOG == 1)
+/**
+ * @brief  log case
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_sim_log(void)
+{
+    uint16_t i;
+    uint16_t len;
+    button_log_t log[BUTTON_LOG_LENGTH];
+    vclock_edge_t edges[4 * BUTTON_LOG_LENGTH];
+    const vclock_edge_t bounce[] = {{100000, 1}, {101000, 0}};
+    const button_t expect[] = {{BUTTON_STATUS_PRESS, 0}};
+    
+    /* one bounce is queued with its time */
+    if (sim_script(bounce, 2, 1000000, expect, 1) != 0)
+    {
+        return 1;
+    }
+    if ((button_log_read(&g_sim_handle, log, BUTTON_LOG_LENGTH, &len) != 0) || (len != 1) || 
+        (log[0].code != BUTTON_LOG_RELEASE_TOO_FAST) || (log[0].t != 1101000))
+    {
+        button_interface_debug_print("sim: log has %d entries.\n", len);
+        
+        return 1;
+    }
+    
+    /* a bounce storm overflows the ring */
+    for (i = 0; i < BUTTON_LOG_LENGTH * 4; i += 2)
+    {
+        edges[i].t = 100000 + (uint64_t)i * 100000;
+        edges[i].level = 1;
+        edges[i + 1].t = edges[i].t + 1000;
+        edges[i + 1].level = 0;
+    }
+    vclock_run(edges, BUTTON_LOG_LENGTH * 4, BUTTON_LOG_LENGTH * 400000 + 1000000, SIM_PERIOD_US, sim_irq, sim_period);
+    if ((button_log_read(&g_sim_handle, log, BUTTON_LOG_LENGTH, &len) != 4) || (len != BUTTON_LOG_LENGTH))
+    {
+        button_interface_debug_print("sim: log overflow is not reported.\n");
+        
+        return 1;
+    }
+    
+    /* the drain prints what is left */
+    vclock_run(bounce, 2, 1000000, SIM_PERIOD_US, sim_irq, sim_period);
+    if ((button_log_drain(&g_sim_handle) != 0) || 
+        (button_log_read(&g_sim_handle, log, BUTTON_LOG_LENGTH, &len) != 0) || (len != 0))
+    {
+        button_interface_debug_print("sim: log is not drained.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+#endif
+
+/**
+ * @brief simulation case table
+ */
+static const sim_case_t gs_case[] =
+{
+    {"single_click", a_sim_single_click},
+    {"double_click", a_sim_double_click},
+    {"triple_click", a_sim_triple_click},
+    {"repeat_click", a_sim_repeat_click},
+    {"short_press", a_sim_short_press},
+    {"long_press", a_sim_long_press},
+    {"bounce", a_sim_bounce},
+    {"timeout", a_sim_timeout},
+    {"click_gap", a_sim_click_gap},
+    {"immediate_click", a_sim_immediate_click},
+    {"immediate_late", a_sim_immediate_late},
+    {"speculative_click", a_sim_speculative_click},
+    {"not_monotonic", a_sim_not_monotonic},
+    {"capture", a_sim_capture},
+    {"capture_late", a_sim_capture_late},
+    {"feed_edges", a_sim_feed_edges},
+    {"feed_same", a_sim_feed_same},
+    {"deadline", a_sim_deadline},
+    {"pull", a_sim_pull},
+    {"batch", a_sim_batch},
+    {"group", a_sim_group},
+    {"group_capture", a_sim_group_capture},
+    {"group_feed", a_sim_group_feed},
+#if (BUTTON_ENABLE_STATS == 1)
+    {"stats", a_sim_stats},
+#endif
+#if (BUTTON_ENABLE_LOG == 1)
+    {"log", a_sim_log},
+#endif
+};
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      without args all cases are run, otherwise only the named cases
+ */
+int main(int argc, char **argv)
+{
+    return sim_run(gs_case, (int)(sizeof(gs_case) / sizeof(sim_case_t)), argc, argv);
+}
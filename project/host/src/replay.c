@@ -0,0 +1,645 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      replay.c
+ * @brief     trace record and replay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_button_interface.h"
+#include "vclock.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief replay definition
+ */
+#define REPLAY_PERIOD_US        (10 * 1000)        /**< 10ms period */
+#define REPLAY_EDGE_MAX         32                 /**< max edges per workload */
+#define REPLAY_BUFFER_SIZE      4096               /**< trace write buffer size */
+#define REPLAY_EVENT_MAX        4096               /**< max checked events */
+#define REPLAY_BLOCK_MAX        65536              /**< max indexed blocks of a recording */
+#define REPLAY_BATCH_MAX        256                /**< max edges per feed */
+
+/**
+ * @brief replay workload structure definition
+ */
+typedef struct replay_workload_s
+{
+    const char *name;                        /**< workload name */
+    vclock_edge_t edge[REPLAY_EDGE_MAX];     /**< edges */
+    uint16_t len;                            /**< edge number */
+    uint64_t end;                            /**< workload length in us */
+} replay_workload_t;
+
+/**
+ * @brief replay event structure definition
+ */
+typedef struct replay_event_s
+{
+    uint64_t tick;           /**< time of the last tick before the event in us */
+    button_t data;           /**< event */
+} replay_event_t;
+
+/**
+ * @brief replay workload table
+ */
+static const replay_workload_t gs_workload[] =
+{
+    {"single_click", {{100000, 1}, {200000, 0}}, 2, 600000},
+    {"double_click", {{100000, 1}, {200000, 0}, {300000, 1}, {400000, 0}}, 4, 800000},
+    {"repeat_click", {{100000, 1}, {150000, 0}, {200000, 1}, {250000, 0}, {300000, 1}, {350000, 0}, 
+                      {400000, 1}, {450000, 0}, {500000, 1}, {550000, 0}}, 10, 1000000},
+    {"short_press", {{100000, 1}, {1600000, 0}}, 2, 2000000},
+    {"long_hold", {{100000, 1}, {4100000, 0}}, 2, 4500000},
+    {"bounce", {{100000, 1}, {100500, 0}, {101000, 1}, {101500, 0}, {200000, 1}, {300000, 0}}, 6, 800000},
+    {"deadline_gap", {{20005, 1}, {1020008, 0}}, 2, 1500000},
+};
+
+static button_handle_t gs_handle;                       /**< button handle */
+static trace_writer_t gs_writer;                        /**< trace writer */
+static uint8_t gs_buf[REPLAY_BUFFER_SIZE];              /**< trace write buffer */
+static FILE *gs_file;                                   /**< trace file */
+static uint8_t gs_write_res;                            /**< trace write result */
+static uint64_t gs_now;                                 /**< time of the running record */
+static uint64_t gs_tick;                                /**< time of the last tick */
+static uint8_t gs_quiet;                                /**< quiet flag */
+static replay_event_t *gs_event;                        /**< saved events */
+static uint32_t gs_event_len;                           /**< saved event number */
+static uint32_t gs_event_total;                         /**< total event number */
+static trace_block_t gs_block[REPLAY_BLOCK_MAX];        /**< block index of a recording */
+static button_edge_t gs_batch[REPLAY_BATCH_MAX];        /**< edges waiting for the feed */
+static uint16_t gs_batch_len;                           /**< waiting edge number */
+static uint64_t gs_from;                                /**< first printed time */
+static uint8_t gs_stats;                                /**< statistics flag */
+
+/**
+ * @brief     get the status name
+ * @param[in] status event status
+ * @return    status name
+ * @note      none
+ */
+static const char *a_replay_status_name(uint16_t status)
+{
+    switch (status)
+    {
+        case BUTTON_STATUS_PRESS :             return "press";
+        case BUTTON_STATUS_RELEASE :           return "release";
+        case BUTTON_STATUS_SINGLE_CLICK :      return "single_click";
+        case BUTTON_STATUS_DOUBLE_CLICK :      return "double_click";
+        case BUTTON_STATUS_TRIPLE_CLICK :      return "triple_click";
+        case BUTTON_STATUS_REPEAT_CLICK :      return "repeat_click";
+        case BUTTON_STATUS_SHORT_PRESS_START : return "short_press_start";
+        case BUTTON_STATUS_SHORT_PRESS_END :   return "short_press_end";
+        case BUTTON_STATUS_LONG_PRESS_START :  return "long_press_start";
+        case BUTTON_STATUS_LONG_PRESS_HOLD :   return "long_press_hold";
+        case BUTTON_STATUS_LONG_PRESS_END :    return "long_press_end";
+        default :                              return "unknown";
+    }
+}
+
+/**
+ * @brief     receive callback
+ * @param[in] *data pointer to an button_t structure
+ * @note      events are printed with the time of the record that delivered them and saved with the
+ *            last tick before them, edges fed together deliver their events with the time of the last one
+ */
+static void a_replay_receive_callback(button_t *data)
+{
+    if (gs_now < gs_from)
+    {
+        return;
+    }
+    if ((gs_event != NULL) && (gs_event_len < REPLAY_EVENT_MAX))
+    {
+        gs_event[gs_event_len].tick = gs_tick;
+        gs_event[gs_event_len].data = *data;
+        gs_event_len++;
+    }
+    gs_event_total++;
+    if (gs_quiet == 0)
+    {
+        printf("%llu %s %u\n", (unsigned long long)gs_now, a_replay_status_name(data->status), data->times);
+    }
+}
+
+/**
+ * @brief     silent print
+ * @param[in] fmt format data
+ * @note      the decoder errors of a trace are part of its replay
+ */
+static void a_replay_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief  init the button
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+static uint8_t a_replay_init(void)
+{
+    DRIVER_BUTTON_LINK_INIT(&gs_handle, button_handle_t);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ(&gs_handle, button_interface_timestamp_read);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ_US(&gs_handle, button_interface_timestamp_read_us);
+    DRIVER_BUTTON_LINK_DELAY_MS(&gs_handle, button_interface_delay_ms);
+    DRIVER_BUTTON_LINK_DEBUG_PRINT(&gs_handle, a_replay_debug_print);
+    DRIVER_BUTTON_LINK_RECEIVE_CALLBACK(&gs_handle, a_replay_receive_callback);
+    if (button_init(&gs_handle) != 0)
+    {
+        printf("trace: init failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     write a record to the trace file
+ * @param[in] kind record kind
+ * @param[in] t timestamp in us
+ * @note      a full buffer is written out and the record is put again
+ */
+static void a_replay_put(uint8_t kind, uint64_t t)
+{
+    uint8_t res;
+    
+    res = trace_writer_put(&gs_writer, kind, t);
+    if (res == 5)
+    {
+        if (fwrite(gs_writer.buf, 1, gs_writer.len, gs_file) != gs_writer.len)
+        {
+            gs_write_res = 1;
+        }
+        trace_writer_reset(&gs_writer);
+        res = trace_writer_put(&gs_writer, kind, t);
+    }
+    if (res != 0)
+    {
+        gs_write_res = 1;
+    }
+}
+
+/**
+ * @brief     recorded irq
+ * @param[in] press_release press or release
+ * @return    status code
+ * @note      the edge is recorded before it reaches the decoder
+ */
+static uint8_t a_replay_record_irq(uint8_t press_release)
+{
+    gs_now = vclock_get_us();
+    a_replay_put(press_release != 0 ? TRACE_KIND_PRESS : TRACE_KIND_RELEASE, gs_now);
+    
+    return button_irq_handler_at(&gs_handle, press_release, gs_now);
+}
+
+/**
+ * @brief  recorded period
+ * @return status code
+ * @note   the tick is recorded before it reaches the decoder
+ */
+static uint8_t a_replay_record_period(void)
+{
+    gs_now = vclock_get_us();
+    gs_tick = gs_now;
+    a_replay_put(TRACE_KIND_TICK, gs_now);
+    
+    return button_period_handler_at(&gs_handle, gs_now);
+}
+
+/**
+ * @brief     record workloads into a trace file
+ * @param[in] *path pointer to a trace path
+ * @param[in] **names pointer to the workload names
+ * @param[in] len workload name number, 0 means all
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ * @note      workloads run back to back on one button
+ */
+static uint8_t a_replay_record(const char *path, char **names, int len)
+{
+    int i;
+    int j;
+    int found;
+    
+    gs_file = fopen(path, "wb");
+    if (gs_file == NULL)
+    {
+        printf("trace: open %s failed.\n", path);
+        
+        return 1;
+    }
+    vclock_set_us(1000000);
+    gs_tick = 0;
+    if (a_replay_init() != 0)
+    {
+        (void)fclose(gs_file);
+        
+        return 1;
+    }
+    gs_write_res = 0;
+    (void)trace_writer_init(&gs_writer, gs_buf, REPLAY_BUFFER_SIZE, vclock_get_us());
+    (void)trace_writer_set_index(&gs_writer, gs_block, REPLAY_BLOCK_MAX);
+    
+    /* run the workloads */
+    for (i = 0; i < (int)(sizeof(gs_workload) / sizeof(gs_workload[0])); i++)
+    {
+        found = (len == 0);
+        for (j = 0; j < len; j++)
+        {
+            if (strcmp(names[j], gs_workload[i].name) == 0)
+            {
+                found = 1;
+            }
+        }
+        if (found != 0)
+        {
+            vclock_run(gs_workload[i].edge, gs_workload[i].len, gs_workload[i].end, REPLAY_PERIOD_US,
+                       a_replay_record_irq, a_replay_record_period);
+        }
+    }
+    (void)button_deinit(&gs_handle);
+    
+    /* append the block index and write the rest */
+    while (trace_writer_finish(&gs_writer) == 5)
+    {
+        if (fwrite(gs_writer.buf, 1, gs_writer.len, gs_file) != gs_writer.len)
+        {
+            gs_write_res = 1;
+        }
+        trace_writer_reset(&gs_writer);
+    }
+    if (fwrite(gs_writer.buf, 1, gs_writer.len, gs_file) != gs_writer.len)
+    {
+        gs_write_res = 1;
+    }
+    if ((fclose(gs_file) != 0) || (gs_write_res != 0))
+    {
+        printf("trace: write %s failed.\n", path);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+#if (BUTTON_ENABLE_STATS == 1)
+/**
+ * @brief  print the decoder statistics
+ * @note   none
+ */
+static void a_replay_print_stats(void)
+{
+    uint8_t i;
+    button_stats_t stats;
+    const char *const reset[BUTTON_RESET_NUM] = {"not_monotonic", "too_fast", "double_press", 
+                                                 "double_release", "click_error", "timeout"};
+    
+    if (button_get_stats(&gs_handle, &stats) != 0)
+    {
+        return;
+    }
+    printf("stats edge_accepted %u\n", stats.edge_accepted);
+    printf("stats edge_rejected %u\n", stats.edge_rejected);
+    for (i = 0; i < BUTTON_RESET_NUM; i++)
+    {
+        printf("stats reset_%s %u\n", reset[i], stats.reset[i]);
+    }
+    for (i = 0; i < BUTTON_STATUS_NUM; i++)
+    {
+        printf("stats event_%s %u\n", a_replay_status_name((uint16_t)(1 << i)), stats.event[i]);
+    }
+    printf("stats decode_max %u\n", stats.decode_max);
+}
+#endif
+
+/**
+ * @brief  feed the waiting edges
+ * @note   the edges between two ticks reach the decoder in one call
+ */
+static void a_replay_flush(void)
+{
+    if (gs_batch_len != 0)
+    {
+        gs_now = gs_batch[gs_batch_len - 1].t;
+        vclock_set_us(gs_now);
+        (void)button_feed_edges(&gs_handle, gs_batch, gs_batch_len);
+        gs_batch_len = 0;
+    }
+}
+
+/**
+ * @brief     replay a trace file
+ * @param[in] *path pointer to a trace path
+ * @param[in] from first printed time in us
+ * @param[in] to last replayed time in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 replay failed
+ * @note      the file is mapped and decoded in place, the edges between two ticks are fed in one
+ *            button_feed_edges call, which decodes them as the recorded irq calls did,
+ *            the replay starts at the block before from, so the decoder is warmed up by the records before it
+ */
+static uint8_t a_replay_run(const char *path, uint64_t from, uint64_t to)
+{
+    uint8_t res;
+    int fd;
+    void *map;
+    size_t size;
+    struct stat st;
+    trace_reader_t reader;
+    trace_record_t record;
+    
+    /* map the file */
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        printf("trace: open %s failed.\n", path);
+        
+        return 1;
+    }
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0))
+    {
+        printf("trace: %s is not a trace.\n", path);
+        (void)close(fd);
+        
+        return 1;
+    }
+    size = (size_t)st.st_size;
+    map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED)
+    {
+        printf("trace: map %s failed.\n", path);
+        
+        return 1;
+    }
+    (void)madvise(map, size, MADV_SEQUENTIAL);
+    if (trace_reader_init(&reader, (const uint8_t *)map, size) != 0)
+    {
+        printf("trace: %s is not a trace.\n", path);
+        (void)munmap(map, size);
+        
+        return 1;
+    }
+    
+    /* start the decoder at the block before the range */
+    (void)trace_reader_seek(&reader, from);
+    vclock_set_us(reader.last);
+    if (a_replay_init() != 0)
+    {
+        (void)munmap(map, size);
+        
+        return 1;
+    }
+    gs_from = from;
+    gs_tick = 0;
+    gs_batch_len = 0;
+    
+    /* feed all records of the range */
+    while ((res = trace_reader_next(&reader, &record)) == 0)
+    {
+        if (record.t > to)
+        {
+            res = 1;
+            
+            break;
+        }
+        if (record.kind == TRACE_KIND_TICK)
+        {
+            a_replay_flush();
+            gs_now = record.t;
+            gs_tick = record.t;
+            vclock_set_us(record.t);
+            (void)button_period_handler_at(&gs_handle, record.t);
+        }
+        else
+        {
+            gs_batch[gs_batch_len].t = record.t;
+            gs_batch[gs_batch_len].level = (record.kind == TRACE_KIND_PRESS) ? 1 : 0;
+            gs_batch_len++;
+            if (gs_batch_len == REPLAY_BATCH_MAX)
+            {
+                a_replay_flush();
+            }
+        }
+    }
+    a_replay_flush();
+#if (BUTTON_ENABLE_STATS == 1)
+    if (gs_stats != 0)
+    {
+        a_replay_print_stats();
+    }
+#endif
+    (void)button_deinit(&gs_handle);
+    (void)munmap(map, size);
+    if (res != 1)
+    {
+        printf("trace: %s is corrupt at byte %lu.\n", path, (unsigned long)reader.pos);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed or the replay differs
+ * @note      button_trace -w <file> [-c] [workload ...]
+ *            button_trace -r <file> [-q] [-s] [-f from_us] [-t to_us]
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int i;
+    uint8_t check;
+    uint32_t len;
+    uint32_t total;
+    uint64_t from;
+    uint64_t to;
+    const char *record_path;
+    const char *replay_path;
+    replay_event_t *live;
+    
+    /* parse the args */
+    check = 0;
+    from = 0;
+    to = 0xFFFFFFFFFFFFFFFFULL;
+    record_path = NULL;
+    replay_path = NULL;
+    while ((c = getopt(argc, argv, "w:r:f:t:cqsh")) != -1)
+    {
+        switch (c)
+        {
+            case 'w' :
+            {
+                record_path = optarg;
+                
+                break;
+            }
+            case 'r' :
+            {
+                replay_path = optarg;
+                
+                break;
+            }
+            case 'f' :
+            {
+                from = strtoull(optarg, NULL, 0);
+                
+                break;
+            }
+            case 't' :
+            {
+                to = strtoull(optarg, NULL, 0);
+                
+                break;
+            }
+            case 'c' :
+            {
+                check = 1;
+                
+                break;
+            }
+            case 'q' :
+            {
+                gs_quiet = 1;
+                
+                break;
+            }
+            case 's' :
+            {
+                gs_stats = 1;
+                
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  button_trace -w <file> [-c] [workload ...]\n");
+                printf("  button_trace -r <file> [-q] [-s] [-f from_us] [-t to_us]\n");
+                printf("\n");
+                printf("Workloads:\n");
+                for (i = 0; i < (int)(sizeof(gs_workload) / sizeof(gs_workload[0])); i++)
+                {
+                    printf("  %s\n", gs_workload[i].name);
+                }
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    }
+    
+    /* replay */
+    if (record_path == NULL)
+    {
+        if (replay_path == NULL)
+        {
+            printf("trace: no trace file.\n");
+            
+            return 1;
+        }
+        
+        return a_replay_run(replay_path, from, to);
+    }
+    
+    /* record quietly, keep the live events when checking */
+    gs_quiet = 1;
+    if (check != 0)
+    {
+        gs_event = (replay_event_t *)malloc(sizeof(replay_event_t) * REPLAY_EVENT_MAX * 2);
+        if (gs_event == NULL)
+        {
+            printf("trace: malloc failed.\n");
+            
+            return 1;
+        }
+    }
+    if (a_replay_record(record_path, &argv[optind], argc - optind) != 0)
+    {
+        free(gs_event);
+        
+        return 1;
+    }
+    if (check == 0)
+    {
+        return 0;
+    }
+    
+    /* replay the written trace and compare with the live events and their tick */
+    live = gs_event;
+    len = gs_event_len;
+    total = gs_event_total;
+    gs_event = live + REPLAY_EVENT_MAX;
+    gs_event_len = 0;
+    gs_event_total = 0;
+    if (a_replay_run(record_path, 0, 0xFFFFFFFFFFFFFFFFULL) != 0)
+    {
+        free(live);
+        
+        return 1;
+    }
+    for (i = 0; i < (int)len; i++)
+    {
+        if ((live[i].tick != gs_event[i].tick) || (live[i].data.status != gs_event[i].data.status) || 
+            (live[i].data.times != gs_event[i].data.times))
+        {
+            break;
+        }
+    }
+    if ((gs_event_total != total) || (gs_event_len != len) || (i != (int)len))
+    {
+        printf("trace: replay of %s differs from the recording.\n", record_path);
+        free(live);
+        
+        return 1;
+    }
+    printf("trace: %u events replayed from %s.\n", total, record_path);
+    free(live);
+    
+    return 0;
+}
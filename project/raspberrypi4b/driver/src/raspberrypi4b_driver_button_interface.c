@@ -35,7 +35,7 @@
  */
 
 #include "driver_button_interface.h"
-#include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 #include <stdarg.h>
 
@@ -45,19 +45,41 @@
  * @return    status code
  *            - 0 success
  *            - 1 read failed
- * @note      none
+ * @note      CLOCK_MONOTONIC does not follow wall clock steps
  */
 uint8_t button_interface_timestamp_read(button_time_t *t)
 {
-    struct timeval time_s;
+    struct timespec time_s;
     
-    if (gettimeofday(&time_s, NULL) < 0)
+    if (clock_gettime(CLOCK_MONOTONIC, &time_s) < 0)
     {
         return 1;
     }
 
     t->s = time_s.tv_sec;
-    t->us = time_s.tv_usec;
+    t->us = time_s.tv_nsec / 1000;
+    
+    return 0;
+}
+
+/**
+ * @brief      interface timestamp read us
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       CLOCK_MONOTONIC is the clock of the libgpiod edge timestamps
+ */
+uint8_t button_interface_timestamp_read_us(uint64_t *us)
+{
+    struct timespec time_s;
+    
+    if (clock_gettime(CLOCK_MONOTONIC, &time_s) < 0)
+    {
+        return 1;
+    }
+    
+    *us = (uint64_t)time_s.tv_sec * 1000000 + (uint64_t)time_s.tv_nsec / 1000;
     
     return 0;
 }
@@ -60,6 +60,19 @@
  */
 uint8_t gpio_interrupt_init(void);
 
+/**
+ * @brief     gpio interrupt init with many lines
+ * @param[in] *offsets pointer to a line offset buffer
+ * @param[in] len line number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      all lines are requested in one bulk request and served by one thread,
+ *            an edge of offsets[i] is reported to g_gpio_irq_index_at with index i,
+ *            len is limited by the libgpiod bulk request and every offset must be below 64
+ */
+uint8_t gpio_interrupt_init_lines(const uint32_t *offsets, uint16_t len);
+
 /**
  * @brief  gpio interrupt deinit
  * @return status code
@@ -35,8 +35,15 @@
  */
 
 #include "gpio.h"
+#include "driver_button.h"
 #include <gpiod.h>
 #include <pthread.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
 
 /**
  * @brief gpio device name definition
@@ -46,69 +53,264 @@
 /**
  * @brief gpio device line definition
  */
-#define GPIO_DEVICE_LINE 17                      /**< gpio device line */
+#define GPIO_DEVICE_LINE 17                             /**< gpio device line */
+#define GPIO_OFFSET_MAX  64                             /**< max line offset + 1, one bit each in the used mask */
+#define GPIO_BULK_MAX    GPIOD_LINE_BULK_MAX_LINES      /**< max lines in one bulk request */
+#define GPIO_EVENT_MAX   32                             /**< max events read in one syscall */
+
+/**
+ * @brief gpio epoll tag definition
+ */
+#define GPIO_TAG_TIMER   0x10000                 /**< timer fd tag */
+#define GPIO_TAG_STOP    0x10001                 /**< stop fd tag */
+
+/**
+ * @brief gpio period definition
+ */
+#define GPIO_PERIOD_US       (100 * 1000)                  /**< 100ms */
+#define GPIO_DEADLINE_NEVER  0xFFFFFFFFFFFFFFFFULL         /**< no deadline */
 
 /**
  * @brief global var definition
  */
-static struct gpiod_chip *gs_chip;                         /**< gpio chip handle */
-static struct gpiod_line *gs_line;                         /**< gpio line handle */
-static pthread_t gs_pid;                                   /**< gpio pthread pid */
-extern uint8_t (*g_gpio_irq)(uint8_t press_release);       /**< gpio irq */
+static struct gpiod_chip *gs_chip;                                  /**< gpio chip handle */
+static struct gpiod_line_bulk gs_bulk;                              /**< gpio line bulk */
+static struct gpiod_line *gs_line[GPIO_OFFSET_MAX];                 /**< gpio line handle by offset */
+static uint16_t gs_index[GPIO_OFFSET_MAX];                          /**< button index by offset */
+static pthread_t gs_pid;                                            /**< gpio pthread pid */
+static int gs_epoll_fd = -1;                                        /**< epoll fd */
+static int gs_timer_fd = -1;                                        /**< timer fd */
+static int gs_stop_fd = -1;                                         /**< stop event fd */
+static uint64_t gs_period_us;                                       /**< last period time */
+extern uint8_t (*g_gpio_irq)(uint8_t press_release);                /**< gpio irq */
+extern uint8_t (*g_gpio_irq_at)(uint8_t press_release, 
+                                uint64_t us);                       /**< gpio irq with the kernel timestamp */
+extern uint8_t (*g_gpio_irq_index_at)(uint16_t index, 
+                                      uint8_t press_release, 
+                                      uint64_t us);                 /**< gpio irq of one line with the kernel timestamp */
+extern uint8_t (*g_gpio_feed_edges)(uint16_t index, 
+                                    const button_edge_t *edges, 
+                                    uint16_t len);                  /**< gpio edge burst of one line with the kernel timestamps */
+extern uint8_t (*g_period_irq)(void);                               /**< period irq */
+extern uint8_t (*g_period_deadline)(uint64_t *us, 
+                                    uint8_t *hold);                 /**< period deadline */
 
 /**
- * @brief  gpio interrupt pthread
- * @param  *p pointer to an args buffer
- * @return NULL
+ * @brief     run the gpio irq
+ * @param[in] index line index
+ * @param[in] press_release press or release
+ * @param[in] us kernel timestamp of the edge in us
+ * @note      the kernel timestamp of the edge is used if g_gpio_irq_index_at or g_gpio_irq_at is set,
+ *            g_gpio_irq_at and g_gpio_irq get the edges of all lines
+ */
+static void a_gpio_irq(uint16_t index, uint8_t press_release, uint64_t us)
+{
+    /* check the g_gpio_irq_index_at */
+    if (g_gpio_irq_index_at != NULL)
+    {
+        /* run the callback */
+        g_gpio_irq_index_at(index, press_release, us);
+    }
+    else if (g_gpio_irq_at != NULL)
+    {
+        /* run the callback */
+        g_gpio_irq_at(press_release, us);
+    }
+    else if (g_gpio_irq != NULL)
+    {
+        /* run the callback */
+        g_gpio_irq(press_release);
+    }
+}
+
+/**
+ * @brief  read the monotonic time
+ * @return time in us
  * @note   none
  */
-static void *a_gpio_interrupt_pthread(void *p)
+static uint64_t a_gpio_time_us(void)
 {
-    int res;
-    struct gpiod_line_event event;
+    struct timespec ts;
     
-    /* enable catching cancel signal */
-    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+    /* read the clock */
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
 
-    /* cancel the pthread at once */
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
+/**
+ * @brief  arm the timer from the next deadline
+ * @note   a long press hold is reported once per GPIO_PERIOD_US,
+ *         any other deadline is armed as it is and a passed one fires at once
+ */
+static void a_gpio_timer_arm(void)
+{
+    uint8_t hold;
+    uint64_t deadline;
+    struct itimerspec spec;
+    
+    /* clear the timer */
+    memset(&spec, 0, sizeof(struct itimerspec));
+    
+    /* get the next deadline */
+    if (g_period_deadline(&deadline, &hold) != 0)
+    {
+        deadline = GPIO_DEADLINE_NEVER;
+        hold = 0;
+    }
+    
+    /* keep the hold period */
+    if ((hold != 0) && (gs_period_us + GPIO_PERIOD_US < deadline))
+    {
+        deadline = gs_period_us + GPIO_PERIOD_US;
+    }
+    
+    /* if a deadline is pending */
+    if (deadline != GPIO_DEADLINE_NEVER)
+    {
+        /* set the absolute time, a passed deadline fires at once */
+        spec.it_value.tv_sec = deadline / 1000000;
+        spec.it_value.tv_nsec = (deadline % 1000000) * 1000;
+    }
+    
+    /* arm or disarm the timer */
+    (void)timerfd_settime(gs_timer_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+}
 
+/**
+ * @brief  gpio event loop pthread
+ * @param  *p pointer to an args buffer
+ * @return NULL
+ * @note   the edges, the period handler and the stop request are all served in this thread
+ */
+static void *a_gpio_interrupt_pthread(void *p)
+{
+    int i;
+    int j;
+    int n;
+    int m;
+    int k;
+    uint32_t tag;
+    uint8_t timer;
+    uint64_t expirations;
+    struct epoll_event events[GPIO_BULK_MAX + 2];
+    struct gpiod_line_event event[GPIO_EVENT_MAX];
+    button_edge_t edge[GPIO_EVENT_MAX];
+    
     /* loop */
     while (1)
     {
-        /* wait for the event */
-        res = gpiod_line_event_wait(gs_line, NULL);
-        if (res == 1)
+        /* arm the timer from the deadline */
+        if (g_period_deadline != NULL)
         {
-            /* read the event */
-            if (gpiod_line_event_read(gs_line, &event) != 0)
+            a_gpio_timer_arm();
+        }
+        
+        /* wait for the events */
+        n = epoll_wait(gs_epoll_fd, events, GPIO_BULK_MAX + 2, -1);
+        if (n < 0)
+        {
+            if (errno == EINTR)
             {
                 continue;
             }
             
-            /* if the rising edge */
-            if (event.event_type == GPIOD_LINE_EVENT_RISING_EDGE)
+            return NULL;
+        }
+        
+        /* decode the edges of all ready lines before the deadline */
+        timer = 0;
+        for (i = 0; i < n; i++)
+        {
+            tag = events[i].data.u32;
+            if (tag == GPIO_TAG_STOP)
             {
-                /* check the g_gpio_irq */
-                if (g_gpio_irq != NULL)
-                {
-                    /* run the callback */
-                    g_gpio_irq(0);
-                }
+                return NULL;
             }
-
-            /* if the falling edge */
-            if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
+            else if (tag == GPIO_TAG_TIMER)
+            {
+                timer = 1;
+            }
+            else
             {
-                /* check the g_gpio_irq */
-                if (g_gpio_irq != NULL)
+                /* read all pending events of the line in one syscall */
+                m = gpiod_line_event_read_multiple(gs_line[tag], event, GPIO_EVENT_MAX);
+                if (m <= 0)
+                {
+                    continue;
+                }
+                
+                /* convert the burst, the falling edge is the press */
+                k = 0;
+                for (j = 0; j < m; j++)
                 {
-                    /* run the callback */
-                    g_gpio_irq(1);
+                    if ((event[j].event_type == GPIOD_LINE_EVENT_RISING_EDGE) || 
+                        (event[j].event_type == GPIOD_LINE_EVENT_FALLING_EDGE))
+                    {
+                        edge[k].t = (uint64_t)event[j].ts.tv_sec * 1000000 + 
+                                    (uint64_t)event[j].ts.tv_nsec / 1000;
+                        edge[k].level = (event[j].event_type == GPIOD_LINE_EVENT_FALLING_EDGE) ? 1 : 0;
+                        k++;
+                    }
+                }
+                
+                /* feed the whole burst at once */
+                if (g_gpio_feed_edges != NULL)
+                {
+                    (void)g_gpio_feed_edges(gs_index[tag], edge, (uint16_t)k);
+                }
+                else
+                {
+                    /* run all edges in order */
+                    for (j = 0; j < k; j++)
+                    {
+                        a_gpio_irq(gs_index[tag], edge[j].level, edge[j].t);
+                    }
                 }
             }
         }
+        
+        /* run the period handler */
+        if (timer != 0)
+        {
+            /* clear the timer */
+            (void)read(gs_timer_fd, &expirations, sizeof(uint64_t));
+            
+            /* save the period time */
+            gs_period_us = a_gpio_time_us();
+            
+            /* check the g_period_irq */
+            if (g_period_irq != NULL)
+            {
+                /* run the callback */
+                g_period_irq();
+            }
+        }
+    }
+}
+
+/**
+ * @brief  close all fds
+ * @note   none
+ */
+static void a_gpio_close(void)
+{
+    if (gs_stop_fd >= 0)
+    {
+        close(gs_stop_fd);
+        gs_stop_fd = -1;
+    }
+    if (gs_timer_fd >= 0)
+    {
+        close(gs_timer_fd);
+        gs_timer_fd = -1;
     }
+    if (gs_epoll_fd >= 0)
+    {
+        close(gs_epoll_fd);
+        gs_epoll_fd = -1;
+    }
+    gpiod_chip_close(gs_chip);
 }
 
 /**
@@ -119,8 +321,55 @@ static void *a_gpio_interrupt_pthread(void *p)
  * @note   none
  */
 uint8_t gpio_interrupt_init(void)
+{
+    uint32_t offset = GPIO_DEVICE_LINE;
+    
+    return gpio_interrupt_init_lines(&offset, 1);
+}
+
+/**
+ * @brief     gpio interrupt init with many lines
+ * @param[in] *offsets pointer to a line offset buffer
+ * @param[in] len line number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      all lines are requested in one bulk request and served by one thread,
+ *            an edge of offsets[i] is reported to g_gpio_irq_index_at with index i,
+ *            len is limited by the libgpiod bulk request and every offset must be below 64
+ */
+uint8_t gpio_interrupt_init_lines(const uint32_t *offsets, uint16_t len)
 {
     uint8_t res;
+    uint16_t i;
+    uint64_t used;
+    unsigned int lines[GPIO_BULK_MAX];
+    struct epoll_event ev;
+    struct itimerspec spec;
+    
+    /* check the lines */
+    if ((len == 0) || (len > GPIO_BULK_MAX))
+    {
+        fprintf(stderr, "gpio: line number is invalid.\n");
+
+        return 1;
+    }
+    used = 0;
+    memset(gs_line, 0, sizeof(struct gpiod_line *) * GPIO_OFFSET_MAX);
+    for (i = 0; i < len; i++)
+    {
+        if ((offsets[i] >= GPIO_OFFSET_MAX) || ((used & (1ULL << offsets[i])) != 0))
+        {
+            fprintf(stderr, "gpio: line offset is invalid.\n");
+
+            return 1;
+        }
+        used |= 1ULL << offsets[i];
+        
+        /* build the offset to index table */
+        gs_index[offsets[i]] = i;
+        lines[i] = offsets[i];
+    }
     
     /* open the gpio group */
     gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
@@ -131,9 +380,8 @@ uint8_t gpio_interrupt_init(void)
         return 1;
     }
     
-    /* get the gpio line */
-    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
-    if (gs_line == NULL) 
+    /* get the gpio lines */
+    if (gpiod_chip_get_lines(gs_chip, lines, len, &gs_bulk) != 0)
     {
         perror("gpio: get line failed.\n");
         gpiod_chip_close(gs_chip);
@@ -141,21 +389,74 @@ uint8_t gpio_interrupt_init(void)
         return 1;
     }
 
-    /* catch the rising and falling edge */
-    if (gpiod_line_request_both_edges_events(gs_line, "gpiointerrupt") < 0)
+    /* catch the rising and falling edge of all lines at once */
+    if (gpiod_line_request_bulk_both_edges_events(&gs_bulk, "gpiointerrupt") < 0)
     {
         perror("gpio: set edge events failed.\n");
         gpiod_chip_close(gs_chip);
 
         return 1;
     }
+    
+    /* creat the event fds */
+    gs_epoll_fd = epoll_create1(0);
+    gs_timer_fd = timerfd_create(CLOCK_MONOTONIC, 0);
+    gs_stop_fd = eventfd(0, 0);
+    if ((gs_epoll_fd < 0) || (gs_timer_fd < 0) || (gs_stop_fd < 0))
+    {
+        perror("gpio: creat event fd failed.\n");
+        a_gpio_close();
+
+        return 1;
+    }
+    
+    /* add the line fds tagged with the offset */
+    memset(&ev, 0, sizeof(struct epoll_event));
+    ev.events = EPOLLIN;
+    for (i = 0; i < len; i++)
+    {
+        gs_line[lines[i]] = gs_bulk.lines[i];
+        ev.data.u32 = lines[i];
+        if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, gpiod_line_event_get_fd(gs_bulk.lines[i]), &ev) != 0)
+        {
+            perror("gpio: add line fd failed.\n");
+            a_gpio_close();
+
+            return 1;
+        }
+    }
+    
+    /* add the timer and the stop fd */
+    ev.data.u32 = GPIO_TAG_TIMER;
+    if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, gs_timer_fd, &ev) != 0)
+    {
+        perror("gpio: add timer fd failed.\n");
+        a_gpio_close();
+
+        return 1;
+    }
+    ev.data.u32 = GPIO_TAG_STOP;
+    if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, gs_stop_fd, &ev) != 0)
+    {
+        perror("gpio: add stop fd failed.\n");
+        a_gpio_close();
+
+        return 1;
+    }
+    
+    /* run a fixed period until a deadline source is set */
+    gs_period_us = a_gpio_time_us();
+    spec.it_value.tv_sec = 0;
+    spec.it_value.tv_nsec = GPIO_PERIOD_US * 1000;
+    spec.it_interval = spec.it_value;
+    (void)timerfd_settime(gs_timer_fd, 0, &spec, NULL);
 
     /* creat a gpio interrupt pthread */
     res = pthread_create(&gs_pid, NULL, a_gpio_interrupt_pthread, NULL);
     if (res != 0)
     {
         perror("gpio: creat pthread failed.\n");
-        gpiod_chip_close(gs_chip);
+        a_gpio_close();
 
         return 1;
     }
@@ -172,11 +473,19 @@ uint8_t gpio_interrupt_init(void)
  */
 uint8_t gpio_interrupt_deinit(void)
 {
-    uint8_t res;
+    uint64_t stop;
     
-    /* close the gpio interrupt pthread */
-    res = pthread_cancel(gs_pid);
-    if (res != 0)
+    /* stop the gpio interrupt pthread */
+    stop = 1;
+    if (write(gs_stop_fd, &stop, sizeof(uint64_t)) != sizeof(uint64_t))
+    {
+        perror("gpio: delete pthread failed.\n");
+
+        return 1;
+    }
+    
+    /* wait for the pthread */
+    if (pthread_join(gs_pid, NULL) != 0)
     {
         perror("gpio: delete pthread failed.\n");
 
@@ -184,7 +493,7 @@ uint8_t gpio_interrupt_deinit(void)
     }
 
     /* close the gpio */
-    gpiod_chip_close(gs_chip);
+    a_gpio_close();
     
     return 0;
 }
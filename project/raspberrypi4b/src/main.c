@@ -35,11 +35,10 @@
  */
 
 #include "driver_button_basic.h"
+#include "driver_button_panel.h"
 #include "driver_button_trigger_test.h"
 #include "gpio.h"
 #include <unistd.h>
-#include <signal.h>
-#include <sys/time.h>
 #include <getopt.h>
 #include <stdlib.h>
 
@@ -47,20 +46,40 @@
  * @brief global var definition
  */
 uint8_t (*g_gpio_irq)(uint8_t press_release) = NULL;        /**< gpio irq */
+uint8_t (*g_gpio_irq_at)(uint8_t press_release, 
+                         uint64_t us) = NULL;               /**< gpio irq with the kernel timestamp */
+uint8_t (*g_gpio_irq_index_at)(uint16_t index, 
+                               uint8_t press_release, 
+                               uint64_t us) = NULL;         /**< gpio irq of one line with the kernel timestamp */
+uint8_t (*g_gpio_feed_edges)(uint16_t index, 
+                             const button_edge_t *edges, 
+                             uint16_t len) = NULL;          /**< gpio edge burst of one line with the kernel timestamps */
 uint8_t (*g_period_irq)(void) = NULL;                       /**< period irq */
+uint8_t (*g_period_deadline)(uint64_t *us, 
+                            uint8_t *hold) = NULL;          /**< period deadline */
 volatile uint16_t g_flag;                                   /**< interrupt flag */
 
 /**
- * @brief     timer handler
- * @param[in] signum signal number
- * @note      none
+ * @brief panel line definition
  */
-static void a_timer_handler(int signum)
+#define PANEL_LINE_NUM    3                                            /**< panel button number */
+static const uint32_t gs_panel_line[PANEL_LINE_NUM] = {17, 27, 22};   /**< panel line offsets */
+
+/**
+ * @brief     feed the edge burst of the basic line
+ * @param[in] index line index
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the basic example has one line
+ */
+static uint8_t a_basic_feed_edges(uint16_t index, const button_edge_t *edges, uint16_t len)
 {
-    if (g_period_irq != NULL)
-    {
-        g_period_irq();
-    }
+    (void)index;
+    
+    return button_basic_feed_edges(edges, len);
 }
 
 /**
@@ -279,7 +298,9 @@ uint8_t button(uint8_t argc, char **argv)
 
         /* set the irq */
         g_gpio_irq = button_trigger_test_irq_handler;
+        g_gpio_irq_at = button_trigger_test_irq_handler_at;
         g_period_irq = button_trigger_test_period_handler;
+        g_period_deadline = button_trigger_test_get_next_deadline;
 
         /* run the trigger test */
         res = button_trigger_test();
@@ -287,7 +308,9 @@ uint8_t button(uint8_t argc, char **argv)
         {
             (void)gpio_interrupt_deinit();
             g_gpio_irq = NULL;
+            g_gpio_irq_at = NULL;
             g_period_irq = NULL;
+            g_period_deadline = NULL;
             
             return 1;
         }
@@ -295,7 +318,9 @@ uint8_t button(uint8_t argc, char **argv)
         /* gpio deinit */
         (void)gpio_interrupt_deinit();
         g_gpio_irq = NULL;
+        g_gpio_irq_at = NULL;
         g_period_irq = NULL;
+        g_period_deadline = NULL;
 
         return 0;
     }
@@ -313,7 +338,10 @@ uint8_t button(uint8_t argc, char **argv)
 
         /* set the irq */
         g_gpio_irq = button_basic_irq_handler;
+        g_gpio_irq_at = button_basic_irq_handler_at;
+        g_gpio_feed_edges = a_basic_feed_edges;
         g_period_irq = button_basic_period_handler;
+        g_period_deadline = button_basic_get_next_deadline;
 
         /* basic init */
         res = button_basic_init(a_receive_callback);
@@ -321,7 +349,10 @@ uint8_t button(uint8_t argc, char **argv)
         {
             (void)gpio_interrupt_deinit();
             g_gpio_irq = NULL;
+            g_gpio_irq_at = NULL;
+            g_gpio_feed_edges = NULL;
             g_period_irq = NULL;
+            g_period_deadline = NULL;
             
             return 1;
         }
@@ -336,7 +367,7 @@ uint8_t button(uint8_t argc, char **argv)
         while (timeout != 0)
         {
             /* check the flag */
-            if ((g_flag & 0x07FF) == 0x07FF)
+            if ((g_flag & BUTTON_STATUS_ENABLED) == BUTTON_STATUS_ENABLED)
             {
                 break;
             }
@@ -344,6 +375,9 @@ uint8_t button(uint8_t argc, char **argv)
             /* timeout -- */
             timeout--;
 
+            /* print the decoder log */
+            (void)button_basic_log_drain();
+
             /* delay 10ms */
             button_interface_delay_ms(10);
         }
@@ -356,7 +390,10 @@ uint8_t button(uint8_t argc, char **argv)
             (void)button_basic_deinit();
             (void)gpio_interrupt_deinit();
             g_gpio_irq = NULL;
+            g_gpio_irq_at = NULL;
+            g_gpio_feed_edges = NULL;
             g_period_irq = NULL;
+            g_period_deadline = NULL;
 
             return 1;
         }
@@ -370,7 +407,93 @@ uint8_t button(uint8_t argc, char **argv)
         /* gpio deinit */
         (void)gpio_interrupt_deinit();
         g_gpio_irq = NULL;
+        g_gpio_irq_at = NULL;
+        g_gpio_feed_edges = NULL;
         g_period_irq = NULL;
+        g_period_deadline = NULL;
+
+        return 0;
+    }
+    else if (strcmp("e_panel", type) == 0)
+    {
+        uint8_t res;
+        uint32_t timeout;
+
+        /* gpio init with all panel lines */
+        res = gpio_interrupt_init_lines(gs_panel_line, PANEL_LINE_NUM);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* set the irq */
+        g_gpio_irq_index_at = button_panel_irq_handler_at;
+        g_gpio_feed_edges = button_panel_feed_edges;
+        g_period_irq = button_panel_period_handler;
+        g_period_deadline = button_panel_get_next_deadline;
+
+        /* panel init */
+        res = button_panel_init(PANEL_LINE_NUM, a_receive_callback);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq_index_at = NULL;
+            g_gpio_feed_edges = NULL;
+            g_period_irq = NULL;
+            g_period_deadline = NULL;
+            
+            return 1;
+        }
+
+        /* 100s timeout */
+        timeout = 10000;
+
+        /* init 0 */
+        g_flag = 0;
+
+        /* check timeout */
+        while (timeout != 0)
+        {
+            /* check the flag */
+            if ((g_flag & BUTTON_STATUS_ENABLED) == BUTTON_STATUS_ENABLED)
+            {
+                break;
+            }
+
+            /* timeout -- */
+            timeout--;
+
+            /* delay 10ms */
+            button_interface_delay_ms(10);
+        }
+
+        /* check the timeout */
+        if (timeout == 0)
+        {
+            /* receive timeout */
+            button_interface_debug_print("button: trigger timeout.\n");
+            (void)button_panel_deinit();
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq_index_at = NULL;
+            g_gpio_feed_edges = NULL;
+            g_period_irq = NULL;
+            g_period_deadline = NULL;
+
+            return 1;
+        }
+
+        /* trigger all */
+        button_interface_debug_print("button: trigger all.\n");
+
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq_index_at = NULL;
+        g_gpio_feed_edges = NULL;
+        g_period_irq = NULL;
+        g_period_deadline = NULL;
+
+        /* panel deinit */
+        (void)button_panel_deinit();
 
         return 0;
     }
@@ -383,13 +506,14 @@ uint8_t button(uint8_t argc, char **argv)
         button_interface_debug_print("  button (-p | --port)\n");
         button_interface_debug_print("  button (-t trigger | --test=trigger)\n");
         button_interface_debug_print("  button (-e trigger | --example=trigger)\n");
+        button_interface_debug_print("  button (-e panel | --example=panel)\n");
         button_interface_debug_print("\n");
         button_interface_debug_print("Options:\n");
-        button_interface_debug_print("  -e <trigger>, --example=<trigger>    Run the driver example.\n");
-        button_interface_debug_print("  -h, --help                           Show the help.\n");
-        button_interface_debug_print("  -i, --information                    Show the chip information.\n");
-        button_interface_debug_print("  -p, --port                           Display the pin connections of the current board.\n");
-        button_interface_debug_print("  -t <trigger>, --test=<trigger>       Run the driver test.\n");
+        button_interface_debug_print("  -e <trigger | panel>, --example=<trigger | panel>    Run the driver example.\n");
+        button_interface_debug_print("  -h, --help                                           Show the help.\n");
+        button_interface_debug_print("  -i, --information                                    Show the chip information.\n");
+        button_interface_debug_print("  -p, --port                                           Display the pin connections of the current board.\n");
+        button_interface_debug_print("  -t <trigger>, --test=<trigger>                       Run the driver test.\n");
 
         return 0;
     }
@@ -415,6 +539,7 @@ uint8_t button(uint8_t argc, char **argv)
     {
         /* print pin connection */
         button_interface_debug_print("button: INT connected to GPIO17(BCM).\n");
+        button_interface_debug_print("button: panel INT connected to GPIO17, GPIO27 and GPIO22(BCM).\n");
 
         return 0;
     }
@@ -435,21 +560,6 @@ uint8_t button(uint8_t argc, char **argv)
 int main(uint8_t argc, char **argv)
 {
     uint8_t res;
-    struct itimerval timer;
-    struct sigaction sa;
-
-    /* init timer handler */
-    sa.sa_handler = a_timer_handler;
-    sigemptyset(&sa.sa_mask);
-    sa.sa_flags = 0;
-    sigaction(SIGALRM, &sa, NULL);
-
-    /* init timer */
-    timer.it_value.tv_sec = 0;
-    timer.it_value.tv_usec = 100 * 1000;
-    timer.it_interval.tv_sec = 0;
-    timer.it_interval.tv_usec = 100 * 1000;
-    setitimer(ITIMER_REAL, &timer, NULL);
 
     res = button(argc, argv);
     if (res == 0)
@@ -44,6 +44,7 @@
  * @brief timer var definition
  */
 static uint64_t gs_second = 0;        /**< second */
+static volatile uint64_t gs_us = 0;   /**< microsecond of the elapsed seconds */
 
 /**
  * @brief     timer callback
@@ -53,6 +54,7 @@ static uint64_t gs_second = 0;        /**< second */
 static void gs_tim_irq(uint32_t us)
 {
     gs_second += us / 1000000;
+    gs_us += us;
 }
 
 /**
@@ -101,6 +103,39 @@ uint8_t button_interface_timestamp_read(button_time_t *t)
     return 0;
 }
 
+/**
+ * @brief      interface timestamp read us
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the timestamp must be monotonic,
+ *             gs_us is read again after the counter, so a timer irq in between restarts the read,
+ *             a pending overflow that the timer irq has not served yet adds one period,
+ *             the timer irq priority must not be lower than the button irq priority
+ */
+uint8_t button_interface_timestamp_read_us(uint64_t *us)
+{
+    TIM_HandleTypeDef *htim;
+    uint64_t base;
+    uint32_t cnt;
+    
+    htim = tim_get_handle();
+    do
+    {
+        base = gs_us;
+        cnt = htim->Instance->CNT;
+        if (__HAL_TIM_GET_FLAG(htim, TIM_FLAG_UPDATE) != RESET)
+        {
+            /* the counter wrapped, read it again after the wrap */
+            cnt = htim->Instance->CNT + htim->Instance->ARR + 1;
+        }
+    } while (base != gs_us);
+    *us = base + cnt;
+    
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
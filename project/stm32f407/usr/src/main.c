@@ -379,7 +379,7 @@ uint8_t button(uint8_t argc, char **argv)
         while (timeout != 0)
         {
             /* check the flag */
-            if ((g_flag & 0x07FF) == 0x07FF)
+            if ((g_flag & BUTTON_STATUS_ENABLED) == BUTTON_STATUS_ENABLED)
             {
                 break;
             }
@@ -387,6 +387,9 @@ uint8_t button(uint8_t argc, char **argv)
             /* timeout -- */
             timeout--;
 
+            /* print the decoder log */
+            (void)button_basic_log_drain();
+
             /* delay 10ms */
             button_interface_delay_ms(10);
         }
@@ -57,61 +57,1188 @@
 #define BUTTON_INTERVAL         (5 * 1000)             /**< 5ms */
 #define BUTTON_TIMEOUT          (1000 * 1000)          /**< 1s */
 
+/**
+ * @brief button edge queue definition
+ */
+#if (BUTTON_ENABLE_CAPTURE == 1)
+    #define BUTTON_EDGE_MASK             (BUTTON_EDGE_LENGTH - 1)                       /**< edge mask */
+    #define BUTTON_EDGE_PENDING(handle)  ((handle)->edge_tail != (handle)->edge_head)   /**< captured edges wait */
+#else
+    #define BUTTON_EDGE_PENDING(handle)  0                                              /**< no capture */
+#endif
+
+/**
+ * @brief button event queue mask definition
+ */
+#if (BUTTON_ENABLE_EVENT_QUEUE == 1)
+    #define BUTTON_EVENT_MASK       (BUTTON_EVENT_LENGTH - 1)   /**< event mask */
+#endif
+
+/**
+ * @brief button batch definition
+ */
+#if (BUTTON_ENABLE_BATCH == 1)
+    #define BUTTON_FLUSH(handle)    a_button_flush(handle)      /**< report the batch */
+#else
+    #define BUTTON_FLUSH(handle)                                /**< no batch */
+#endif
+
+/**
+ * @brief button memory barrier definition
+ * @note  define BUTTON_BARRIER for compilers without the gnu builtins
+ */
+#ifndef BUTTON_BARRIER
+    #if defined(__GNUC__)
+        #define BUTTON_BARRIER()    __sync_synchronize()    /**< full barrier */
+    #else
+        #define BUTTON_BARRIER()                            /**< volatile ordering only */
+    #endif
+#endif
+
+/**
+ * @brief button atomic bit definition
+ * @note  define BUTTON_ATOMIC_OR and BUTTON_ATOMIC_AND for compilers without the gnu builtins,
+ *        or as a critical section on cores without atomic instructions
+ */
+#ifndef BUTTON_ATOMIC_OR
+    #if defined(__GNUC__)
+        #define BUTTON_ATOMIC_OR(p, v)     ((void)__sync_fetch_and_or(p, v))     /**< atomic or */
+    #else
+        #define BUTTON_ATOMIC_OR(p, v)     (*(p) |= (v))                         /**< plain or */
+    #endif
+#endif
+#ifndef BUTTON_ATOMIC_AND
+    #if defined(__GNUC__)
+        #define BUTTON_ATOMIC_AND(p, v)    ((void)__sync_fetch_and_and(p, v))    /**< atomic and */
+    #else
+        #define BUTTON_ATOMIC_AND(p, v)    (*(p) &= (v))                         /**< plain and */
+    #endif
+#endif
+
+/**
+ * @brief button log mask definition
+ */
+#define BUTTON_LOG_MASK         (BUTTON_LOG_LENGTH - 1)     /**< log mask */
+
+/**
+ * @brief button log entry definition
+ */
+#if (BUTTON_ENABLE_LOG == 1)
+    #define BUTTON_LOG(handle, code, t)    a_button_log(handle, code, t)    /**< queue a log entry */
+#else
+    #define BUTTON_LOG(handle, code, t)    ((void)(t))                      /**< no log */
+#endif
+
+/**
+ * @brief button statistics counter definition
+ */
+#if (BUTTON_ENABLE_STATS == 1)
+    #define BUTTON_STATS_INC(handle, counter)    ((handle)->stats.counter++)    /**< count */
+#else
+    #define BUTTON_STATS_INC(handle, counter)                                    /**< no count */
+#endif
+
+/**
+ * @brief button event definition
+ */
+#define BUTTON_EVENT_PRESS      0                      /**< press edge */
+#define BUTTON_EVENT_RELEASE    1                      /**< release edge */
+#define BUTTON_EVENT_TIMER      2                      /**< deadline reached */
+#define BUTTON_EVENT_NUM        3                      /**< event number */
+
+/**
+ * @brief button state number definition
+ */
+#define BUTTON_STATE_NUM        9                      /**< state number */
+
+/**
+ * @brief button timer definition
+ */
+#define BUTTON_TIMER_NONE       0                      /**< no deadline */
+#define BUTTON_TIMER_SHORT      1                      /**< press time + short time */
+#define BUTTON_TIMER_LONG       2                      /**< press time + long time */
+#define BUTTON_TIMER_REPEAT     3                      /**< last time + repeat time */
+#define BUTTON_TIMER_NOW        4                      /**< last time */
+#define BUTTON_TIMER_TIMEOUT    5                      /**< last time + timeout */
+
+/**
+ * @brief button action definition
+ */
+#define BUTTON_ACTION_NONE              0              /**< no action */
+#define BUTTON_ACTION_ACCEPT            1              /**< save the edge */
+#define BUTTON_ACTION_EMIT              2              /**< report the status */
+#define BUTTON_ACTION_EMIT_CHAIN        3              /**< report the status and check the next deadline */
+#define BUTTON_ACTION_EMIT_RESET        4              /**< report the status and reset */
+#define BUTTON_ACTION_CLICK             5              /**< report the clicks and reset */
+#define BUTTON_ACTION_DOUBLE_PRESS      6              /**< double press error */
+#define BUTTON_ACTION_DOUBLE_RELEASE    7              /**< double release error */
+#define BUTTON_ACTION_TIMEOUT           8              /**< timeout error */
+#define BUTTON_ACTION_REPORT            9              /**< save the edge, report the status and reset */
+
+/**
+ * @brief button gesture timer definition
+ */
+#if (BUTTON_ENABLE_LONG_PRESS == 1)
+    #define BUTTON_TIMER_SHORT_HELD     BUTTON_TIMER_LONG      /**< wait for the long press */
+#else
+    #define BUTTON_TIMER_SHORT_HELD     BUTTON_TIMER_NONE      /**< wait for the release */
+#endif
+#if (BUTTON_ENABLE_LONG_HOLD == 1)
+    #define BUTTON_TIMER_LONG_HELD      BUTTON_TIMER_LONG      /**< hold on every period */
+#else
+    #define BUTTON_TIMER_LONG_HELD      BUTTON_TIMER_NONE      /**< wait for the release */
+#endif
+
+/**
+ * @brief button gesture status definition
+ */
+#if (BUTTON_ENABLE_SHORT_PRESS == 1)
+    #define BUTTON_REPORT_SHORT_START   BUTTON_STATUS_SHORT_PRESS_START    /**< report the short press start */
+    #define BUTTON_REPORT_SHORT_END     BUTTON_STATUS_SHORT_PRESS_END      /**< report the short press end */
+#else
+    #define BUTTON_REPORT_SHORT_START   0                                  /**< not reported */
+    #define BUTTON_REPORT_SHORT_END     0                                  /**< not reported */
+#endif
+
+/**
+ * @brief button state information structure definition
+ */
+typedef struct button_state_info_s
+{
+    uint8_t level;                    /**< level of the last accepted edge */
+    uint8_t timer;                    /**< deadline type */
+} button_state_info_t;
+
+/**
+ * @brief button transition structure definition
+ */
+typedef struct button_transition_s
+{
+    uint8_t next;                     /**< next state */
+    uint8_t action;                   /**< action */
+    uint16_t status;                  /**< reported status */
+} button_transition_t;
+
+/**
+ * @brief button state information table
+ */
+static const button_state_info_t gs_state_info[BUTTON_STATE_NUM] =
+{
+    {0, BUTTON_TIMER_NONE},           /* idle */
+    {1, BUTTON_TIMER_SHORT},          /* pressed */
+    {1, BUTTON_TIMER_SHORT_HELD},     /* short held */
+    {1, BUTTON_TIMER_LONG_HELD},      /* long held */
+    {0, BUTTON_TIMER_REPEAT},         /* released wait */
+    {0, BUTTON_TIMER_NOW},            /* short released */
+    {0, BUTTON_TIMER_NOW},            /* long released */
+    {1, BUTTON_TIMER_TIMEOUT},        /* click pressed */
+    {0, BUTTON_TIMER_REPEAT},         /* clicking */
+};
+
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+/**
+ * @brief button immediate click transition
+ * @note  replaces the release of the pressed state in the immediate click mode
+ */
+static const button_transition_t gs_transition_immediate = 
+{
+    BUTTON_STATE_IDLE, BUTTON_ACTION_REPORT, BUTTON_STATUS_SINGLE_CLICK
+};
+#endif
+
+/**
+ * @brief button transition table
+ */
+static const button_transition_t gs_transition[BUTTON_STATE_NUM][BUTTON_EVENT_NUM] =
+{
+    {   /* idle */
+        {BUTTON_STATE_PRESSED, BUTTON_ACTION_ACCEPT, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_RELEASE, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_NONE, 0},
+    },
+    {   /* pressed */
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_PRESS, 0},
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+        {BUTTON_STATE_RELEASED_WAIT, BUTTON_ACTION_ACCEPT, 0},
+#else
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_REPORT, BUTTON_STATUS_SINGLE_CLICK},
+#endif
+        {BUTTON_STATE_SHORT_HELD, BUTTON_ACTION_EMIT_CHAIN, BUTTON_REPORT_SHORT_START},
+    },
+    {   /* short held */
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_PRESS, 0},
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+        {BUTTON_STATE_SHORT_RELEASED, BUTTON_ACTION_ACCEPT, 0},
+#else
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_REPORT, BUTTON_REPORT_SHORT_END},
+#endif
+        {BUTTON_STATE_LONG_HELD, BUTTON_ACTION_EMIT, BUTTON_STATUS_LONG_PRESS_START},
+    },
+    {   /* long held */
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_PRESS, 0},
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+        {BUTTON_STATE_LONG_RELEASED, BUTTON_ACTION_ACCEPT, 0},
+#else
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_REPORT, BUTTON_STATUS_LONG_PRESS_END},
+#endif
+        {BUTTON_STATE_LONG_HELD, BUTTON_ACTION_EMIT, BUTTON_STATUS_LONG_PRESS_HOLD},
+    },
+    {   /* released wait */
+        {BUTTON_STATE_CLICK_PRESSED, BUTTON_ACTION_ACCEPT, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_RELEASE, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_CLICK, 0},
+    },
+    {   /* short released */
+        {BUTTON_STATE_CLICK_PRESSED, BUTTON_ACTION_ACCEPT, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_RELEASE, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_EMIT_RESET, BUTTON_REPORT_SHORT_END},
+    },
+    {   /* long released */
+        {BUTTON_STATE_CLICK_PRESSED, BUTTON_ACTION_ACCEPT, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_RELEASE, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_EMIT_RESET, BUTTON_STATUS_LONG_PRESS_END},
+    },
+    {   /* click pressed */
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_PRESS, 0},
+        {BUTTON_STATE_CLICKING, BUTTON_ACTION_ACCEPT, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_TIMEOUT, 0},
+    },
+    {   /* clicking */
+        {BUTTON_STATE_CLICK_PRESSED, BUTTON_ACTION_ACCEPT, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_DOUBLE_RELEASE, 0},
+        {BUTTON_STATE_IDLE, BUTTON_ACTION_CLICK, 0},
+    },
+};
+
+#if (BUTTON_ENABLE_LOG == 1)
+/**
+ * @brief button log string table
+ */
+static const char *const gs_log_string[BUTTON_LOG_NUM] =
+{
+    "button: timestamp read failed.\n",
+    "button: timestamp is not monotonic.\n",
+    "button: press too fast.\n",
+    "button: release too fast.\n",
+    "button: double press.\n",
+    "button: double release.\n",
+    "button: double click error.\n",
+    "button: triple click error.\n",
+    "button: repeat click error.\n",
+    "button: reset checking.\n",
+};
+#endif
+
 /**
  * @brief     set param
  * @param[in] *handle pointer to a button handle structure
  * @note      none
  */
-static void a_button_set_param(button_handle_t *handle)
+static void a_button_set_param(button_handle_t *handle)
+{
+    handle->short_time = BUTTON_SHORT_TIME;          /* set default short time */
+#if (BUTTON_ENABLE_LONG_PRESS == 1)
+    handle->long_time = BUTTON_LONG_TIME;            /* set default long time */
+#endif
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+    handle->repeat_time = BUTTON_REPEAT_TIME;        /* set default repeat time */
+    handle->click_mode = BUTTON_CLICK_MODE_MULTI;    /* set default click mode */
+#endif
+    handle->interval = BUTTON_INTERVAL;              /* set default interval */
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+    handle->timeout = BUTTON_TIMEOUT; /* set default timeout */
+#endif
+}
+
+/**
+ * @brief      read timestamp
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       timestamp_read_us is used if linked, otherwise timestamp_read is converted once here
+ */
+static uint8_t a_button_timestamp_read(button_handle_t *handle, uint64_t *us)
+{
+    button_time_t t;
+    
+    if (handle->timestamp_read_us != NULL)                   /* check timestamp_read_us */
+    {
+        return handle->timestamp_read_us(us);                /* read us directly */
+    }
+    
+    if (handle->timestamp_read(&t) != 0)                     /* timestamp read */
+    {
+        return 1;                                            /* return error */
+    }
+    *us = t.s * 1000000 + t.us;                              /* convert to us */
+    
+    return 0;                                                /* success return 0 */
+}
+
+#if (BUTTON_ENABLE_LOG == 1)
+/**
+ * @brief     queue a log entry
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] code log code
+ * @param[in] t timestamp in us
+ * @note      the entry is dropped if the log ring is full
+ */
+static void a_button_log(button_handle_t *handle, uint8_t code, uint64_t t)
+{
+    uint16_t head;
+    
+    head = handle->log_head;                                    /* get the head */
+    if ((uint16_t)(head - handle->log_tail) >= 
+        BUTTON_LOG_LENGTH)                                      /* check the ring */
+    {
+        handle->log_dropped++;                                  /* dropped++ */
+        
+        return;                                                 /* return */
+    }
+    handle->log[head & BUTTON_LOG_MASK].t = t;                  /* save the time */
+    handle->log[head & BUTTON_LOG_MASK].code = code;            /* save the code */
+    BUTTON_BARRIER();                                           /* publish the entry before the head */
+    handle->log_head = head + 1;                                /* head++ */
+}
+#endif
+
+#if (BUTTON_ENABLE_STATS == 1)
+/**
+ * @brief     count a reported status
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] status reported status
+ * @note      none
+ */
+static void a_button_stats_event(button_handle_t *handle, uint16_t status)
+{
+    uint8_t i;
+    
+    for (i = 0; i < BUTTON_STATUS_NUM; i++)                   /* find the status bit */
+    {
+        if ((status & (1 << i)) != 0)                         /* check the bit */
+        {
+            handle->stats.event[i]++;                         /* count the event */
+            
+            return;                                           /* return */
+        }
+    }
+}
+#endif
+
+/**
+ * @brief     report a status
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] status reported status
+ * @param[in] times click times
+ * @note      the batch callback is used first, then the callback, then the event queue
+ */
+static void a_button_emit(button_handle_t *handle, uint16_t status, uint16_t times)
+{
+    button_t button;
+#if (BUTTON_ENABLE_EVENT_QUEUE == 1)
+    uint16_t head;
+#endif
+    
+#if (BUTTON_ENABLE_SHORT_PRESS == 0)
+    if (status == 0)                                                /* if the gesture is removed */
+    {
+        return;                                                     /* return */
+    }
+#endif
+#if (BUTTON_ENABLE_STATS == 1)
+    if ((status & BUTTON_STATUS_FLAG_PROVISIONAL) == 0)             /* count the resolving report only */
+    {
+        a_button_stats_event(handle, status);                       /* count the event */
+    }
+#endif
+    button.status = status;                                         /* set status */
+    button.times = times;                                           /* set times */
+#if (BUTTON_ENABLE_BATCH == 1)
+    if (handle->receive_callback_batch != NULL)                     /* if batch */
+    {
+        handle->batch[handle->batch_len] = button;                  /* save the event */
+        handle->batch_len++;                                        /* length++ */
+        if (handle->batch_len >= BUTTON_BATCH_LENGTH)               /* check the batch length */
+        {
+            handle->receive_callback_batch(handle->batch, 
+                                           handle->batch_len);      /* run the batch callback */
+            handle->batch_len = 0;                                  /* clear the batch */
+        }
+    }
+    else if (handle->receive_callback != NULL)                      /* if callback */
+#else
+    if (handle->receive_callback != NULL)                           /* if callback */
+#endif
+    {
+        handle->receive_callback(&button);                          /* run the reception callback */
+    }
+#if (BUTTON_ENABLE_EVENT_QUEUE == 1)
+    else
+    {
+        head = handle->event_head;                                  /* get the head */
+        if ((uint16_t)(head - handle->event_tail) >= 
+            BUTTON_EVENT_LENGTH)                                    /* check the queue */
+        {
+            handle->event_dropped++;                                /* dropped++ */
+            
+            return;                                                 /* return */
+        }
+        handle->event[head & BUTTON_EVENT_MASK] = button;           /* save the event */
+        BUTTON_BARRIER();                                           /* publish the event before the head */
+        handle->event_head = head + 1;                              /* head++ */
+    }
+#endif
+}
+
+/**
+ * @brief     reset all
+ * @param[in] *handle pointer to a button handle structure
+ * @note      a pending provisional single click is confirmed,
+ *            the last edge time is kept for the interval and the timestamp check
+ */
+static void a_button_reset(button_handle_t *handle)
+{
+    handle->state = BUTTON_STATE_IDLE;               /* set idle */
+    handle->decode_len = 0;                          /* reset the decode */
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+    if (handle->provisional != 0)                    /* if the single click is provisional */
+    {
+        handle->provisional = 0;                     /* clear the flag */
+        a_button_emit(handle, BUTTON_STATUS_SINGLE_CLICK | 
+                      BUTTON_STATUS_FLAG_CONFIRM, 1);  /* confirm the single click */
+    }
+    handle->click_error = 0;                         /* init 0 */
+#endif
+}
+
+#if (BUTTON_ENABLE_BATCH == 1)
+/**
+ * @brief     report the pending batch
+ * @param[in] *handle pointer to a button handle structure
+ * @note      none
+ */
+static void a_button_flush(button_handle_t *handle)
+{
+    if (handle->batch_len != 0)                                                   /* if events are pending */
+    {
+        handle->receive_callback_batch(handle->batch, handle->batch_len);         /* run the batch callback */
+        handle->batch_len = 0;                                                    /* clear the batch */
+    }
+}
+#endif
+
+/**
+ * @brief     get the deadline of the current state
+ * @param[in] *handle pointer to a button handle structure
+ * @return    deadline in us
+ * @note      none
+ */
+static uint64_t a_button_deadline(button_handle_t *handle)
+{
+    uint64_t deadline;
+    
+    switch (gs_state_info[handle->state].timer)
+    {
+        case BUTTON_TIMER_SHORT :
+        {
+            deadline = handle->press_time + handle->short_time;         /* short press start */
+            
+            break;
+        }
+#if (BUTTON_ENABLE_LONG_PRESS == 1)
+        case BUTTON_TIMER_LONG :
+        {
+            deadline = handle->press_time + handle->long_time;          /* long press start or hold */
+            
+            break;
+        }
+#endif
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+        case BUTTON_TIMER_REPEAT :
+        {
+            deadline = handle->last_time + handle->repeat_time;         /* click end */
+            
+            break;
+        }
+#endif
+        case BUTTON_TIMER_NOW :
+        {
+            deadline = handle->last_time;                               /* at once */
+            
+            break;
+        }
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+        case BUTTON_TIMER_TIMEOUT :
+        {
+            deadline = handle->last_time + handle->timeout;             /* timeout */
+            
+            break;
+        }
+#endif
+        default :
+        {
+            deadline = BUTTON_DEADLINE_NEVER;                           /* never */
+            
+            break;
+        }
+    }
+    
+    return deadline;                                                    /* return the deadline */
+}
+
+/**
+ * @brief     get the next deadline
+ * @param[in] *handle pointer to a button handle structure
+ * @return    deadline in us
+ * @note      the oldest captured edge is due at its timestamp
+ */
+static uint64_t a_button_next_deadline(button_handle_t *handle)
+{
+#if (BUTTON_ENABLE_CAPTURE == 1)
+    uint16_t tail;
+#endif
+    uint64_t deadline;
+    
+    deadline = a_button_deadline(handle);                               /* get the deadline of the state */
+#if (BUTTON_ENABLE_CAPTURE == 1)
+    tail = handle->edge_tail;                                           /* get the tail */
+    if (tail != handle->edge_head)                                      /* if edges are captured */
+    {
+        BUTTON_BARRIER();                                               /* read the edge after the head */
+        if (handle->edge[tail & BUTTON_EDGE_MASK].t < deadline)         /* check the edge time */
+        {
+            deadline = handle->edge[tail & BUTTON_EDGE_MASK].t;         /* decode the edge first */
+        }
+    }
+#endif
+    
+    return deadline;                                                    /* return the deadline */
+}
+
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+/**
+ * @brief     report the clicks
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] t current timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 4 check error
+ * @note      the click times of a removed gesture are not reported,
+ *            a provisional single click is confirmed or superseded here
+ */
+static uint8_t a_button_click(button_handle_t *handle, uint64_t t)
+{
+    uint16_t flag;
+    uint32_t times;
+    
+    times = handle->decode_len / 2;                                       /* get the click times */
+    if (handle->click_error != 0)                                         /* check the streaming result */
+    {
+        if (times == 2)                                                   /* double click */
+        {
+            BUTTON_LOG(handle, BUTTON_LOG_DOUBLE_CLICK_ERROR, t);          /* double click error */
+        }
+        else if (times == 3)                                              /* triple click */
+        {
+            BUTTON_LOG(handle, BUTTON_LOG_TRIPLE_CLICK_ERROR, t);          /* triple click error */
+        }
+        else
+        {
+            BUTTON_LOG(handle, BUTTON_LOG_REPEAT_CLICK_ERROR, t);          /* repeat click error */
+        }
+        BUTTON_STATS_INC(handle, reset[BUTTON_RESET_CLICK_ERROR]);        /* count the reset */
+        a_button_reset(handle);                                           /* reset all */
+        
+        return 4;                                                         /* return error */
+    }
+    
+    flag = 0;                                                             /* init 0 */
+    if (handle->provisional != 0)                                         /* if the single click is provisional */
+    {
+        flag = (times == 1) ? BUTTON_STATUS_FLAG_CONFIRM : 
+                              BUTTON_STATUS_FLAG_SUPERSEDES;              /* confirm or supersede it */
+    }
+    if (times == 1)                                                       /* single click */
+    {
+        handle->provisional = 0;                                          /* clear the flag */
+        a_button_emit(handle, BUTTON_STATUS_SINGLE_CLICK | flag, 1);      /* single click */
+    }
+#if (BUTTON_ENABLE_DOUBLE_CLICK == 1)
+    else if (times == 2)                                                  /* double click */
+    {
+        handle->provisional = 0;                                          /* clear the flag */
+        a_button_emit(handle, BUTTON_STATUS_DOUBLE_CLICK | flag, 2);      /* double click */
+    }
+#endif
+#if (BUTTON_ENABLE_TRIPLE_CLICK == 1)
+    else if (times == 3)                                                  /* triple click */
+    {
+        handle->provisional = 0;                                          /* clear the flag */
+        a_button_emit(handle, BUTTON_STATUS_TRIPLE_CLICK | flag, 3);      /* triple click */
+    }
+#endif
+#if (BUTTON_ENABLE_REPEAT_CLICK == 1)
+    else if (times > 0xFFFF)                                              /* check the max times */
+    {
+        handle->provisional = 0;                                          /* clear the flag */
+        a_button_emit(handle, BUTTON_STATUS_REPEAT_CLICK | flag, 0xFFFF); /* repeat click */
+    }
+    else if (times > 3)                                                   /* repeat click */
+    {
+        handle->provisional = 0;                                          /* clear the flag */
+        a_button_emit(handle, BUTTON_STATUS_REPEAT_CLICK | flag, 
+                      (uint16_t)times);                                   /* repeat click */
+    }
+#endif
+    a_button_reset(handle);                                               /* reset all */
+    
+    return 0;                                                             /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     decode one edge
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] level press is 1, release is 0
+ * @param[in] t timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ * @note      an edge older than the last accepted time is rejected and the decoder restarts from it,
+ *            the immediate click is only reported for a release before the short time, a longer press
+ *            waits for the short press decision that a_button_feed_edge runs first
+ */
+static uint8_t a_button_edge_handler(button_handle_t *handle, uint8_t level, uint64_t t)
+{
+    uint64_t diff;
+    const button_transition_t *transition;
+    
+    if (t < handle->last_time)                                             /* check the timestamp */
+    {
+        BUTTON_LOG(handle, BUTTON_LOG_NOT_MONOTONIC, t);                   /* timestamp is not monotonic */
+        BUTTON_STATS_INC(handle, reset[BUTTON_RESET_NOT_MONOTONIC]);       /* count the reset */
+        a_button_reset(handle);                                            /* reset all */
+        handle->last_time = t;                                             /* save last time */
+        
+        return 6;                                                          /* return error */
+    }
+    diff = t - handle->last_time;                                          /* now - last time */
+    if (level != gs_state_info[handle->state].level)                       /* if the level changes */
+    {
+        if (diff < handle->interval)                                       /* check diff */
+        {
+            if (level != 0)                                                /* if press */
+            {
+                BUTTON_LOG(handle, BUTTON_LOG_PRESS_TOO_FAST, t);          /* trigger too fast */
+            }
+            else
+            {
+                BUTTON_LOG(handle, BUTTON_LOG_RELEASE_TOO_FAST, t);        /* release too fast */
+            }
+            BUTTON_STATS_INC(handle, edge_rejected);                       /* count the rejected edge */
+            BUTTON_STATS_INC(handle, reset[BUTTON_RESET_TOO_FAST]);        /* count the reset */
+            a_button_reset(handle);                                        /* reset all */
+            handle->last_time = t;                                         /* save last time */
+            
+            return 5;                                                      /* return error */
+        }
+    }
+    
+    if (level != 0)                                                        /* check press release */
+    {
+        a_button_emit(handle, BUTTON_STATUS_PRESS, 0);                     /* press */
+        transition = &gs_transition[handle->state][BUTTON_EVENT_PRESS];    /* get the press transition */
+    }
+    else
+    {
+        a_button_emit(handle, BUTTON_STATUS_RELEASE, 0);                   /* release */
+        transition = &gs_transition[handle->state][BUTTON_EVENT_RELEASE];  /* get the release transition */
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+        if ((handle->state == BUTTON_STATE_PRESSED) && 
+            (handle->click_mode == BUTTON_CLICK_MODE_IMMEDIATE) && 
+            ((t - handle->press_time) < handle->short_time))               /* if the immediate click */
+        {
+            transition = &gs_transition_immediate;                         /* report the click now */
+        }
+#endif
+    }
+    
+    if (transition->action == BUTTON_ACTION_ACCEPT)                        /* if accepted */
+    {
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+        if ((level != 0) && (handle->decode_len != 0))                     /* if a click gap */
+        {
+            if (diff >= handle->repeat_time)                               /* check repeat time */
+            {
+                handle->click_error = 1;                                   /* flag click error */
+            }
+        }
+#endif
+        if (handle->decode_len == 0)                                       /* if the gesture starts */
+        {
+            handle->press_time = t;                                        /* save the press time */
+        }
+        handle->decode_len++;                                              /* length++ */
+        handle->state = transition->next;                                  /* set the next state */
+        BUTTON_STATS_INC(handle, edge_accepted);                           /* count the edge */
+#if (BUTTON_ENABLE_STATS == 1)
+        if (handle->decode_len > handle->stats.decode_max)                 /* check the depth */
+        {
+            handle->stats.decode_max = handle->decode_len;                 /* save the max depth */
+        }
+#endif
+        handle->last_time = t;                                             /* save last time */
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+        if ((handle->state == BUTTON_STATE_RELEASED_WAIT) && 
+            (handle->click_mode == BUTTON_CLICK_MODE_SPECULATIVE))         /* if the first click is released */
+        {
+            handle->provisional = 1;                                       /* flag provisional */
+            a_button_emit(handle, BUTTON_STATUS_SINGLE_CLICK | 
+                          BUTTON_STATUS_FLAG_PROVISIONAL, 1);              /* report the provisional single click */
+        }
+#endif
+        
+        return 0;                                                          /* success return 0 */
+    }
+    else if (transition->action == BUTTON_ACTION_REPORT)                   /* if the release ends the gesture */
+    {
+        BUTTON_STATS_INC(handle, edge_accepted);                           /* count the edge */
+        a_button_emit(handle, transition->status, 
+                      (transition->status == BUTTON_STATUS_SINGLE_CLICK) ? 1 : 0);    /* report the status */
+        a_button_reset(handle);                                            /* reset all */
+        handle->last_time = t;                                             /* save last time */
+        
+        return 0;                                                          /* success return 0 */
+    }
+    else if (transition->action == BUTTON_ACTION_DOUBLE_PRESS)             /* double press */
+    {
+        BUTTON_LOG(handle, BUTTON_LOG_DOUBLE_PRESS, t);                    /* double press */
+        BUTTON_STATS_INC(handle, reset[BUTTON_RESET_DOUBLE_PRESS]);        /* count the reset */
+        a_button_reset(handle);                                            /* reset all */
+        handle->last_time = t;                                             /* save last time */
+        
+        return 4;                                                          /* return error */
+    }
+    else
+    {
+        BUTTON_LOG(handle, BUTTON_LOG_DOUBLE_RELEASE, t);                  /* double release */
+        BUTTON_STATS_INC(handle, reset[BUTTON_RESET_DOUBLE_RELEASE]);      /* count the reset */
+        a_button_reset(handle);                                            /* reset all */
+        handle->last_time = t;                                             /* save last time */
+        
+        return 4;                                                          /* return error */
+    }
+}
+
+/**
+ * @brief     run the due timer decisions
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] t current timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 4 check error
+ * @note      at most two timer transitions run in one call
+ */
+static uint8_t a_button_timer_handler(button_handle_t *handle, uint64_t t)
+{
+    uint8_t i;
+    uint8_t res;
+    const button_transition_t *transition;
+    
+    res = 0;                                                                       /* init 0 */
+    for (i = 0; i < 2; i++)                                                        /* bounded chain */
+    {
+        if (t < a_button_deadline(handle))                                         /* check the deadline */
+        {
+            break;                                                                 /* break */
+        }
+        
+        transition = &gs_transition[handle->state][BUTTON_EVENT_TIMER];            /* get the transition */
+        switch (transition->action)
+        {
+            case BUTTON_ACTION_EMIT :
+            {
+                a_button_emit(handle, transition->status, 0);                      /* report the status */
+                handle->state = transition->next;                                  /* set the next state */
+                
+                return res;                                                        /* return the result */
+            }
+            case BUTTON_ACTION_EMIT_CHAIN :
+            {
+                a_button_emit(handle, transition->status, 0);                      /* report the status */
+                handle->state = transition->next;                                  /* set the next state */
+                
+                break;
+            }
+            case BUTTON_ACTION_EMIT_RESET :
+            {
+                a_button_emit(handle, transition->status, 0);                      /* report the status */
+                a_button_reset(handle);                                            /* reset all */
+                
+                return res;                                                        /* return the result */
+            }
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+            case BUTTON_ACTION_CLICK :
+            {
+                return a_button_click(handle, t);                                  /* report the clicks */
+            }
+            case BUTTON_ACTION_TIMEOUT :
+            {
+                BUTTON_LOG(handle, BUTTON_LOG_RESET_CHECKING, t);                  /* reset checking */
+                BUTTON_STATS_INC(handle, reset[BUTTON_RESET_TIMEOUT]);             /* count the reset */
+                a_button_reset(handle);                                            /* reset all */
+                
+                return 4;                                                          /* return error */
+            }
+#endif
+            default :
+            {
+                return res;                                                        /* return the result */
+            }
+        }
+    }
+    
+    return res;                                                                    /* return the result */
+}
+
+/**
+ * @brief     decode one edge after the decisions due before it
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] level press is 1, release is 0
+ * @param[in] t timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ * @note      the short, long and click decisions are run at their deadline, so an edge is decoded
+ *            the same way whether the period handler ran before it or not,
+ *            every edge entry point decodes through this function
+ */
+static uint8_t a_button_feed_edge(button_handle_t *handle, uint8_t level, uint64_t t)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t res2;
+    uint64_t deadline;
+    
+    res = 0;                                                                      /* init 0 */
+    for (i = 0; i < 3; i++)                                                       /* short, long and click decisions */
+    {
+        deadline = a_button_deadline(handle);                                     /* get the deadline */
+        if ((deadline > t) || 
+            (handle->state == BUTTON_STATE_LONG_HELD))                            /* check the deadline */
+        {
+            break;                                                                /* break */
+        }
+        if (a_button_timer_handler(handle, deadline) != 0)                        /* run the decision at the deadline */
+        {
+            res = 4;                                                              /* check error */
+        }
+    }
+    res2 = a_button_edge_handler(handle, level, t);                               /* decode the edge */
+    
+    return (res2 != 0) ? res2 : res;                                              /* return the result */
+}
+
+#if (BUTTON_ENABLE_CAPTURE == 1)
+/**
+ * @brief     drain the captured edges
+ * @param[in] *handle pointer to a button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 4 trigger error
+ * @note      the decisions due between the captured edges are run at their deadline
+ */
+static uint8_t a_button_edge_drain(button_handle_t *handle)
+{
+    uint8_t ret;
+    uint16_t tail;
+    button_edge_t edge;
+    
+    ret = 0;                                                                   /* init 0 */
+    tail = handle->edge_tail;                                                  /* get the tail */
+    while (tail != handle->edge_head)                                          /* check the queue */
+    {
+        BUTTON_BARRIER();                                                      /* read the edge after the head */
+        edge = handle->edge[tail & BUTTON_EDGE_MASK];                          /* get the edge */
+        BUTTON_BARRIER();                                                      /* free the slot after the read */
+        tail++;                                                                /* tail++ */
+        handle->edge_tail = tail;                                              /* release the slot */
+        if (a_button_feed_edge(handle, edge.level, edge.t) != 0)               /* decode the edge at its time */
+        {
+            ret = 4;                                                           /* trigger error */
+        }
+    }
+    
+    return ret;                                                                /* return the result */
+}
+#endif
+
+/**
+ * @brief     period handler at a given time
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] t current timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 4 check error
+ * @note      the captured edges are decoded first
+ */
+static uint8_t a_button_period_handler(button_handle_t *handle, uint64_t t)
+{
+    uint8_t res;
+    uint8_t res2;
+    
+    res = 0;                                                                       /* init 0 */
+#if (BUTTON_ENABLE_CAPTURE == 1)
+    if (handle->edge_tail != handle->edge_head)                                    /* if edges are captured */
+    {
+        res = a_button_edge_drain(handle);                                         /* decode the captured edges */
+    }
+#endif
+    res2 = a_button_timer_handler(handle, t);                                      /* run the timer decisions */
+    
+    return (res2 != 0) ? res2 : res;                                               /* return the result */
+}
+
+/**
+ * @brief     period handler
+ * @param[in] *handle pointer to a button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 check error
+ * @note      the edges queued by button_irq_capture_handler are decoded first
+ */
+uint8_t button_period_handler(button_handle_t *handle)
+{
+    uint8_t res;
+    uint64_t t;
+    
+    if (handle == NULL)                                                           /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    if ((handle->state != BUTTON_STATE_IDLE) || 
+        BUTTON_EDGE_PENDING(handle))                                              /* if not idle */
+    {
+        res = a_button_timestamp_read(handle, &t);                                /* timestamp read */
+        if (res != 0)                                                             /* check result */
+        {
+            BUTTON_LOG(handle, BUTTON_LOG_TIMESTAMP_READ_FAILED, 
+                       handle->last_time);                                        /* timestamp read failed */
+            
+            return 1;                                                             /* return error */
+        }
+        
+        return button_period_handler_at(handle, t);                               /* run the period handler */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     period handler at a given time
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] now current timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 check error
+ * @note      now must come from the same clock as the linked timestamp read function,
+ *            the edges queued by button_irq_capture_handler are decoded first
+ */
+uint8_t button_period_handler_at(button_handle_t *handle, uint64_t now)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    if ((handle->state != BUTTON_STATE_IDLE) || 
+        BUTTON_EDGE_PENDING(handle))                                     /* if not idle */
+    {
+        res = a_button_period_handler(handle, now);                      /* run the period handler */
+        BUTTON_FLUSH(handle);                                            /* report the batch */
+        
+        return res;                                                      /* return the result */
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the next deadline
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *us pointer to a deadline buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the deadline is the timestamp in us when the period handler can report the next
+ *             short press, long press, click or timeout decision, BUTTON_DEADLINE_NEVER means idle,
+ *             a captured edge that is not decoded yet is due at its timestamp,
+ *             the deadline can be in the past, then the period handler should run at once,
+ *             long press hold is reported once per period handler call, so the host keeps its
+ *             own hold period while a long press is held
+ */
+uint8_t button_get_next_deadline_us(button_handle_t *handle, uint64_t *us)
+{
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if (handle->inited != 1)                             /* check handle initialization */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    *us = a_button_next_deadline(handle);                /* get the deadline */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the decoder state
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       BUTTON_STATE_LONG_HELD tells the host that the deadline is a long press hold
+ */
+uint8_t button_get_state(button_handle_t *handle, button_state_t *state)
 {
-    handle->short_time = BUTTON_SHORT_TIME;          /* set default short time */
-    handle->long_time = BUTTON_LONG_TIME;            /* set default long time */
-    handle->repeat_time = BUTTON_REPEAT_TIME;        /* set default repeat time */
-    handle->interval = BUTTON_INTERVAL;              /* set default interval */
-    handle->timeout = BUTTON_TIMEOUT;                /* set default timeout */
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if (handle->inited != 1)                             /* check handle initialization */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    *state = (button_state_t)(handle->state);            /* get the state */
+    
+    return 0;                                            /* success return 0 */
 }
 
 /**
- * @brief     reset all
+ * @brief     irq handler
  * @param[in] *handle pointer to a button handle structure
- * @note      none
+ * @param[in] press_release press or release
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ * @note      press is 1
+ *            release is 0
  */
-static void a_button_reset(button_handle_t *handle)
+uint8_t button_irq_handler(button_handle_t *handle, uint8_t press_release)
 {
     uint8_t res;
-    button_time_t t;
+    uint64_t t;
     
-    handle->decode_len = 0;                  /* reset the decode */
-    handle->short_triggered = 0;             /* init 0 */
-    handle->long_triggered = 0;              /* init 0 */
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
     
-    res = handle->timestamp_read(&t);        /* timestamp read */
-    if (res != 0)                            /* check result */
+    res = a_button_timestamp_read(handle, &t);                             /* timestamp read */
+    if (res != 0)                                                          /* check result */
     {
-        return;                              /* return error */
+        BUTTON_LOG(handle, BUTTON_LOG_TIMESTAMP_READ_FAILED, 
+                   handle->last_time);                                     /* timestamp read failed */
+        
+        return 1;                                                          /* return error */
     }
-    handle->last_time.s = t.s;               /* save last time */
-    handle->last_time.us = t.us;             /* save last time */
+    
+    return button_irq_handler_at(handle, press_release, t);                /* decode the edge */
 }
 
 /**
- * @brief     period handler
+ * @brief     irq handler at a given time
  * @param[in] *handle pointer to a button handle structure
+ * @param[in] press_release press or release
+ * @param[in] now timestamp of the edge in us
  * @return    status code
  *            - 0 success
- *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 check error
- * @note      none
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ * @note      press is 1
+ *            release is 0
+ *            now must come from the same clock as the linked timestamp read function,
+ *            the timer decisions due before the edge are run at their deadline first,
+ *            so a late period handler does not change the decoded gesture
  */
-uint8_t button_period_handler(button_handle_t *handle)
+uint8_t button_irq_handler_at(button_handle_t *handle, uint8_t press_release, uint64_t now)
 {
     uint8_t res;
-    uint16_t i;
-    uint16_t len;
-    int64_t diff;
-    button_time_t t;
+    
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    res = a_button_feed_edge(handle, 
+                             (press_release != 0) ? 1 : 0, now);           /* decode the edge at its time */
+    BUTTON_FLUSH(handle);                                                  /* report the batch */
+    
+    return res;                                                            /* return the result */
+}
+
+/**
+ * @brief     feed captured edges
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 trigger error
+ * @note      the edges must be in time order and come from the same clock as the linked timestamp read function,
+ *            every edge is decoded as button_irq_handler_at decodes it,
+ *            the decisions after the last edge are left to the period handler
+ */
+uint8_t button_feed_edges(button_handle_t *handle, const button_edge_t *edges, uint16_t len)
+{
+    uint8_t res;
+    uint16_t j;
     
     if (handle == NULL)                                                           /* check handle */
     {
@@ -122,229 +1249,23 @@ uint8_t button_period_handler(button_handle_t *handle)
         return 3;                                                                 /* return error */
     }
     
-    if (handle->decode_len != 0)                                                  /* if decode len is not 0 */
+    res = 0;                                                                      /* init 0 */
+    for (j = 0; j < len; j++)                                                     /* run all edges */
     {
-        res = handle->timestamp_read(&t);                                         /* timestamp read */
-        if (res != 0)                                                             /* check result */
-        {
-            handle->debug_print("button: timestamp read failed.\n");              /* timestamp read failed */
-            
-            return 1;                                                             /* return error */
-        }
-        if (handle->decode_len == 1)                                              /* short or long press */
-        {
-            diff = (int64_t)((int64_t)t.s - 
-                   (int64_t)handle->decode[0].t.s) * 1000000 + 
-                   (int64_t)((int64_t)t.us - (int64_t)handle->decode[0].t.us);    /* now - last time */
-            if ((uint32_t)(diff) >= handle->short_time)                           /* check short time */
-            {
-                if (handle->short_triggered == 0)                                 /* if no triggered */
-                {
-                    button_t button;
-                    
-                    button.status = BUTTON_STATUS_SHORT_PRESS_START;              /* short press start */
-                    button.times = 0;                                             /* 0 times */
-                    handle->receive_callback(&button);                            /* run the reception callback */
-                    handle->short_triggered = 1;                                  /* set triggered */
-                }
-            }
-            if ((uint32_t)(diff) >= handle->long_time)                            /* check long time */
-            {
-                if (handle->long_triggered == 0)                                  /* if no triggered */
-                {
-                    button_t button;
-                    
-                    button.status = BUTTON_STATUS_LONG_PRESS_START;               /* long press start */
-                    button.times = 0;                                             /* 0 times */
-                    handle->receive_callback(&button);                            /* run the reception callback */
-                    handle->long_triggered = 1;                                   /* set triggered */
-                }
-                else
-                {
-                    button_t button;
-                    
-                    button.status = BUTTON_STATUS_LONG_PRESS_HOLD;                /* long press hold */
-                    button.times = 0;                                             /* 0 times */
-                    handle->receive_callback(&button);                            /* run the reception callback */
-                }
-            }
-        }
-        else if (handle->decode_len == 2)                                         /* single click, short or long press */
-        {
-            diff = (int64_t)((int64_t)t.s - 
-                   (int64_t)handle->decode[1].t.s) * 1000000 + 
-                   (int64_t)((int64_t)t.us - (int64_t)handle->decode[1].t.us);    /* now - last time */
-            if (handle->long_triggered != 0)                                      /* if long no triggered */
-            {
-                button_t button;
-                
-                button.status = BUTTON_STATUS_LONG_PRESS_END;                     /* long press end */
-                button.times = 0;                                                 /* 0 times */
-                handle->receive_callback(&button);                                /* run the reception callback */
-                a_button_reset(handle);                                           /* reset all */
-            }
-            else if (handle->short_triggered != 0)                                /* if short no triggered */
-            {
-                button_t button;
-                
-                button.status = BUTTON_STATUS_SHORT_PRESS_END;                    /* long press end */
-                button.times = 0;                                                 /* 0 times */
-                handle->receive_callback(&button);                                /* run the reception callback */
-                a_button_reset(handle);                                           /* reset all */
-            }
-            else
-            {
-                if ((uint32_t)(diff) >= handle->repeat_time)                      /* check repeat time */
-                {
-                    button_t button;
-                    
-                    button.status = BUTTON_STATUS_SINGLE_CLICK;                   /* single click */
-                    button.times = 1;                                             /* 1 times */
-                    handle->receive_callback(&button);                            /* run the reception callback */
-                    a_button_reset(handle);                                       /* reset all */
-                }
-            }
-        }
-        else if (handle->decode_len == 4)                                         /* double click */
-        {
-            diff = (int64_t)((int64_t)t.s - 
-                   (int64_t)handle->last_time.s) * 1000000 + 
-                   (int64_t)((int64_t)t.us - (int64_t)handle->last_time.us);      /* now - last time */
-            if ((uint32_t)(diff) >= handle->repeat_time)                          /* check repeat time */
-            {
-                button_t button;
-                
-                len = handle->decode_len - 1;                                     /* len - 1 */
-                for (i = 0; i < len; i++)                                         /* diff all time */
-                {
-                    int64_t diff2;
-                    
-                    diff2 = (int64_t)((int64_t)handle->decode[i + 1].t.s -
-                            (int64_t)handle->decode[i].t.s) * 1000000 + 
-                            (int64_t)((int64_t)handle->decode[i + 1].t.us -
-                            (int64_t)handle->decode[i].t.us);                     /* diff time */
-                    handle->decode[i].diff_us = (uint32_t)diff2;                  /* save the time diff2 */
-                }
-                handle->decode[3].diff_us = (uint32_t)diff;                       /* save the time diff */
-                
-                for (i = 1; i < len; i += 2)                                      /* check decode length */
-                {
-                    if (handle->decode[i].diff_us >= handle->repeat_time)         /* check repeat time */
-                    {
-                        handle->debug_print("button: double click error.\n");     /* double click error */
-                        a_button_reset(handle);                                   /* reset all */
-                        
-                        return 4;                                                 /* return error */
-                    }
-                }
-                
-                button.status = BUTTON_STATUS_DOUBLE_CLICK;                       /* double click */
-                button.times = 2;                                                 /* 2 times */
-                handle->receive_callback(&button);                                /* run the reception callback */
-                a_button_reset(handle);                                           /* reset all */
-            }
-        }
-        else if (handle->decode_len == 6)                                         /* triple click */
-        {
-            diff = (int64_t)((int64_t)t.s - 
-                   (int64_t)handle->last_time.s) * 1000000 + 
-                   (int64_t)((int64_t)t.us - (int64_t)handle->last_time.us);      /* now - last time */
-            if ((uint32_t)(diff) >= handle->repeat_time)                          /* check repeat time */
-            {
-                button_t button;
-                
-                len = handle->decode_len - 1;                                     /* len - 1 */
-                for (i = 0; i < len; i++)                                         /* diff all time */
-                {
-                    int64_t diff2;
-                    
-                    diff2 = (int64_t)((int64_t)handle->decode[i + 1].t.s -
-                            (int64_t)handle->decode[i].t.s) * 1000000 + 
-                            (int64_t)((int64_t)handle->decode[i + 1].t.us -
-                            (int64_t)handle->decode[i].t.us);                     /* diff time */
-                    handle->decode[i].diff_us = (uint32_t)diff2;                  /* save the time diff2 */
-                }
-                handle->decode[5].diff_us = (uint32_t)diff;                       /* save the time diff */
-                
-                for (i = 1; i < len; i += 2)                                      /* check decode length */
-                {
-                    if (handle->decode[i].diff_us >= handle->repeat_time)         /* check repeat time */
-                    {
-                        handle->debug_print("button: triple click error.\n");     /* triple click error */
-                        a_button_reset(handle);                                   /* reset all */
-                        
-                        return 4;                                                 /* return error */
-                    }
-                }
-                
-                button.status = BUTTON_STATUS_TRIPLE_CLICK;                       /* triple click */
-                button.times = 3;                                                 /* 3 times */
-                handle->receive_callback(&button);                                /* run the reception callback */
-                a_button_reset(handle);                                           /* reset all */
-            }
-        }
-        else
+        if (a_button_feed_edge(handle, (edges[j].level != 0) ? 1 : 0, 
+                               edges[j].t) != 0)                                  /* decode the edge at its time */
         {
-            if ((handle->decode_len > 6) && (handle->decode_len % 2 == 0))        /* check time */
-            {
-                diff = (int64_t)((int64_t)t.s - 
-                       (int64_t)handle->last_time.s) * 1000000 + 
-                       (int64_t)((int64_t)t.us - (int64_t)handle->last_time.us);  /* now - last time */
-                if ((uint32_t)(diff) >= handle->repeat_time)                      /* check repeat time */
-                {
-                    button_t button;
-                    
-                    len = handle->decode_len - 1;                                 /* len - 1 */
-                    for (i = 0; i < len; i++)                                     /* diff all time */
-                    {
-                        int64_t diff2;
-                        
-                        diff2 = (int64_t)((int64_t)handle->decode[i + 1].t.s -
-                                (int64_t)handle->decode[i].t.s) * 1000000 + 
-                                (int64_t)((int64_t)handle->decode[i + 1].t.us -
-                                (int64_t)handle->decode[i].t.us);                 /* diff time */
-                        handle->decode[i].diff_us = (uint32_t)diff2;              /* save the time diff2 */
-                    }
-                    handle->decode[len].diff_us = (uint32_t)diff;                 /* save the time diff */
-                    
-                    for (i = 1; i < len; i += 2)                                  /* check decode length */
-                    {
-                        if (handle->decode[i].diff_us >= handle->repeat_time)     /* check repeat time */
-                        {
-                            handle->debug_print("button: repeat click error.\n"); /* repeat click error */
-                            a_button_reset(handle);                               /* reset all */
-                            
-                            return 4;                                             /* return error */
-                        }
-                    }
-                    
-                    button.status = BUTTON_STATUS_REPEAT_CLICK;                   /* repeat click */
-                    button.times = handle->decode_len / 2;                        /* decode times */
-                    handle->receive_callback(&button);                            /* run the reception callback */
-                    a_button_reset(handle);                                       /* reset all */
-                }
-            }
-            else
-            {
-                diff = (int64_t)((int64_t)t.s - 
-                       (int64_t)handle->last_time.s) * 1000000 + 
-                       (int64_t)((int64_t)t.us - (int64_t)handle->last_time.us);  /* now - last time */
-                if ((uint32_t)(diff) >= handle->timeout)                          /* check timeout */
-                {
-                    handle->debug_print("button: reset checking.\n");             /* reset checking */
-                    a_button_reset(handle);                                       /* reset all */
-                    
-                    return 4;                                                     /* return error */
-                }
-            }
+            res = 4;                                                              /* trigger error */
         }
     }
+    BUTTON_FLUSH(handle);                                                         /* report the batch */
     
-    return 0;                                                                     /* success return 0 */
+    return res;                                                                   /* return the result */
 }
 
+#if (BUTTON_ENABLE_CAPTURE == 1)
 /**
- * @brief     irq handler
+ * @brief     irq capture handler
  * @param[in] *handle pointer to a button handle structure
  * @param[in] press_release press or release
  * @return    status code
@@ -352,127 +1273,281 @@ uint8_t button_period_handler(button_handle_t *handle)
  *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 trigger error
- *            - 5 trigger too fast
+ *            - 4 queue is full
  * @note      press is 1
  *            release is 0
+ *            only the timestamp and the level are queued here, the edge is decoded in the period handler,
+ *            this function is the only producer and the period handler is the only consumer of the queue
  */
-uint8_t button_irq_handler(button_handle_t *handle, uint8_t press_release)
+uint8_t button_irq_capture_handler(button_handle_t *handle, uint8_t press_release)
 {
-    uint8_t res;
-    int64_t diff;
-    button_time_t t;
+    uint16_t head;
+    uint64_t t;
     
-    if (handle == NULL)                                                    /* check handle */
+    if (handle == NULL)                                                            /* check handle */
     {
-        return 2;                                                          /* return error */
+        return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                               /* check handle initialization */
+    if (handle->inited != 1)                                                       /* check handle initialization */
     {
-        return 3;                                                          /* return error */
+        return 3;                                                                  /* return error */
     }
     
-    res = handle->timestamp_read(&t);                                      /* timestamp read */
-    if (res != 0)                                                          /* check result */
+    if (a_button_timestamp_read(handle, &t) != 0)                                  /* timestamp read */
     {
-        handle->debug_print("button: timestamp read failed.\n");           /* timestamp read failed */
+        return 1;                                                                  /* return error */
+    }
+    head = handle->edge_head;                                                      /* get the head */
+    if ((uint16_t)(head - handle->edge_tail) >= BUTTON_EDGE_LENGTH)                /* check the queue */
+    {
+        handle->edge_dropped++;                                                    /* dropped++ */
         
-        return 1;                                                          /* return error */
+        return 4;                                                                  /* return error */
+    }
+    handle->edge[head & BUTTON_EDGE_MASK].t = t;                                   /* save the time */
+    handle->edge[head & BUTTON_EDGE_MASK].level = (press_release != 0) ? 1 : 0;    /* save the level */
+    BUTTON_BARRIER();                                                              /* publish the edge before the head */
+    handle->edge_head = head + 1;                                                  /* head++ */
+    
+    return 0;                                                                      /* success return 0 */
+}
+#endif
+
+#if (BUTTON_ENABLE_EVENT_QUEUE == 1)
+/**
+ * @brief      read the queued events
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *buf pointer to an event buffer
+ * @param[in]  n max event number
+ * @param[out] *len pointer to a read length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 events were dropped since the last read
+ * @note       the events are only queued when no reception callback is linked,
+ *             the queued events are still read when 4 is returned,
+ *             this function is the only consumer of the event queue
+ */
+uint8_t button_read_events(button_handle_t *handle, button_t *buf, uint16_t n, uint16_t *len)
+{
+    uint16_t i;
+    uint16_t tail;
+    uint32_t dropped;
+    
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
     }
-    diff = (int64_t)((int64_t)t.s - 
-           (int64_t)handle->last_time.s) * 1000000 + 
-           (int64_t)((int64_t)t.us - (int64_t)handle->last_time.us);       /* now - last time */
-    if (press_release != 0)                                                /* if press */
+    if (handle->inited != 1)                                        /* check handle initialization */
     {
-        if ((handle->decode_len % 2) == 0)                                 /* press */
-        {
-            if ((uint32_t)(diff) < handle->interval)                       /* check diff */
-            {
-                handle->debug_print("button: press too fast.\n");          /* trigger too fast */
-                a_button_reset(handle);                                    /* reset all */
-                
-                return 5;                                                  /* success return 0 */
-            }
-        }
+        return 3;                                                   /* return error */
+    }
+    
+    tail = handle->event_tail;                                      /* get the tail */
+    for (i = 0; (i < n) && (tail != handle->event_head); i++)       /* read all events */
+    {
+        BUTTON_BARRIER();                                           /* read the event after the head */
+        buf[i] = handle->event[tail & BUTTON_EVENT_MASK];           /* copy the event */
+        tail++;                                                     /* tail++ */
+    }
+    BUTTON_BARRIER();                                               /* free the slots after the read */
+    handle->event_tail = tail;                                      /* release the slots */
+    *len = i;                                                       /* output the length */
+    
+    dropped = handle->event_dropped;                                /* get the dropped number */
+    if (dropped != handle->event_dropped_read)                      /* check the dropped number */
+    {
+        handle->event_dropped_read = dropped;                       /* save the dropped number */
+        
+        return 4;                                                   /* return error */
+    }
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the dropped event number
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *dropped pointer to a dropped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the number counts all events dropped since init because the event queue was full
+ */
+uint8_t button_get_event_dropped(button_handle_t *handle, uint32_t *dropped)
+{
+    if (handle == NULL)                       /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    if (handle->inited != 1)                  /* check handle initialization */
+    {
+        return 3;                             /* return error */
+    }
+    
+    *dropped = handle->event_dropped;         /* get the dropped number */
+    
+    return 0;                                 /* success return 0 */
+}
+#endif
+
+#if (BUTTON_ENABLE_STATS == 1)
+/**
+ * @brief      get the statistics
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the counters are written by the decoder context without locking,
+ *             read them from the same context for an exact snapshot,
+ *             a provisional single click is not counted, its confirm or superseding click is
+ */
+uint8_t button_get_stats(button_handle_t *handle, button_stats_t *stats)
+{
+    if (handle == NULL)                       /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    if (handle->inited != 1)                  /* check handle initialization */
+    {
+        return 3;                             /* return error */
+    }
+    
+    *stats = handle->stats;                   /* copy the statistics */
+    
+    return 0;                                 /* success return 0 */
+}
+
+/**
+ * @brief     reset the statistics
+ * @param[in] *handle pointer to a button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t button_reset_stats(button_handle_t *handle)
+{
+    if (handle == NULL)                                         /* check handle */
+    {
+        return 2;                                               /* return error */
+    }
+    if (handle->inited != 1)                                    /* check handle initialization */
+    {
+        return 3;                                               /* return error */
+    }
+    
+    memset(&handle->stats, 0, sizeof(button_stats_t));          /* clear the statistics */
+    
+    return 0;                                                   /* success return 0 */
+}
+#endif
+
+#if (BUTTON_ENABLE_LOG == 1)
+/**
+ * @brief      read the queued log entries
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *buf pointer to a log buffer
+ * @param[in]  n max entry number
+ * @param[out] *len pointer to a read length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 entries were dropped since the last read
+ * @note       the queued entries are still read when 4 is returned,
+ *             this function and button_log_drain are the only consumers of the log ring
+ */
+uint8_t button_log_read(button_handle_t *handle, button_log_t *buf, uint16_t n, uint16_t *len)
+{
+    uint16_t i;
+    uint16_t tail;
+    uint32_t dropped;
+    
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
     }
-    else                                                                   /* if release */
+    if (handle->inited != 1)                                        /* check handle initialization */
     {
-        if ((handle->decode_len % 2) != 0)                                 /* release */
-        {
-            if ((uint32_t)(diff) < handle->interval)                       /* check diff */
-            {
-                handle->debug_print("button: release too fast.\n");        /* release too fast */
-                a_button_reset(handle);                                    /* reset all */
-                
-                return 5;                                                  /* success return 0 */
-            }
-        }
+        return 3;                                                   /* return error */
     }
     
-    if (press_release != 0)                                                /* check press release */
+    tail = handle->log_tail;                                        /* get the tail */
+    for (i = 0; (i < n) && (tail != handle->log_head); i++)         /* read all entries */
     {
-        if (handle->receive_callback != NULL)                              /* if not null */
-        {
-            button_t button;
-            
-            button.status = BUTTON_STATUS_PRESS;                           /* press */
-            button.times = 0;                                              /* 0 times */
-            handle->receive_callback(&button);                             /* run the reception callback */
-        }
+        BUTTON_BARRIER();                                           /* read the entry after the head */
+        buf[i] = handle->log[tail & BUTTON_LOG_MASK];               /* copy the entry */
+        tail++;                                                     /* tail++ */
     }
-    else
+    BUTTON_BARRIER();                                               /* free the slots after the read */
+    handle->log_tail = tail;                                        /* release the slots */
+    *len = i;                                                       /* output the length */
+    
+    dropped = handle->log_dropped;                                  /* get the dropped number */
+    if (dropped != handle->log_dropped_read)                        /* check the dropped number */
     {
-        if (handle->receive_callback != NULL)                              /* if not null */
-        {
-            button_t button;
-            
-            button.status = BUTTON_STATUS_RELEASE;                         /* release */
-            button.times = 0;                                              /* 0 times */
-            handle->receive_callback(&button);                             /* run the reception callback */
-        }
+        handle->log_dropped_read = dropped;                         /* save the dropped number */
+        
+        return 4;                                                   /* return error */
     }
     
-    if (handle->decode_len >= (BUTTON_LENGTH - 1))                         /* check the max length */
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     print the queued log entries
+ * @param[in] *handle pointer to a button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it from a low priority context, the entries are formatted by debug_print
+ */
+uint8_t button_log_drain(button_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t i;
+    uint16_t len;
+    uint32_t dropped;
+    button_log_t log[4];
+    
+    if (handle == NULL)                                                      /* check handle */
     {
-        a_button_reset(handle);                                            /* reset all */
+        return 2;                                                            /* return error */
     }
-    if (press_release != 0)                                                /* if press */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        if ((handle->decode_len % 2) == 0)                                 /* press */
-        {
-            handle->decode[handle->decode_len].t.s = t.s;                  /* save s */
-            handle->decode[handle->decode_len].t.us = t.us;                /* save us */
-            handle->decode_len++;                                          /* length++ */
-        }
-        else
-        {
-            handle->debug_print("button: double press.\n");                /* double press */
-            a_button_reset(handle);                                        /* reset all */
-            
-            return 4;                                                      /* return error */
-        }
+        return 3;                                                            /* return error */
     }
-    else                                                                   /* if release */
+    
+    dropped = handle->log_dropped_read;                                      /* save the seen dropped number */
+    do
     {
-        if ((handle->decode_len % 2) != 0)                                 /* release */
+        res = button_log_read(handle, log, 4, &len);                         /* read a chunk */
+        if (res == 4)                                                        /* if entries were dropped */
         {
-            handle->decode[handle->decode_len].t.s = t.s;                  /* save s */
-            handle->decode[handle->decode_len].t.us = t.us;                /* save us */
-            handle->decode_len++;                                          /* length++ */
+            handle->debug_print("button: %d log entries dropped.\n", 
+                                (int)(handle->log_dropped_read - dropped));  /* print the dropped number */
+            dropped = handle->log_dropped_read;                              /* save the seen dropped number */
         }
-        else
+        for (i = 0; i < len; i++)                                            /* print all entries */
         {
-            handle->debug_print("button: double release.\n");              /* double release */
-            a_button_reset(handle);                                        /* reset all */
-            
-            return 4;                                                      /* return error */
+            if (log[i].code < BUTTON_LOG_NUM)                                /* check the code */
+            {
+                handle->debug_print(gs_log_string[log[i].code]);             /* print the entry */
+            }
         }
-    }
-    handle->last_time.s = t.s;                                             /* save last time */
-    handle->last_time.us = t.us;                                           /* save last time */
+    } while (len != 0);                                                      /* until empty */
     
-    return 0;                                                              /* success return 0 */
+    return 0;                                                                /* success return 0 */
 }
+#endif
 
 /**
  * @brief     initialize the chip
@@ -487,7 +1562,7 @@ uint8_t button_irq_handler(button_handle_t *handle, uint8_t press_release)
 uint8_t button_init(button_handle_t *handle)
 {
     uint8_t res;
-    button_time_t t;
+    uint64_t t;
     
     if (handle == NULL)                                                    /* check handle */
     {
@@ -497,7 +1572,8 @@ uint8_t button_init(button_handle_t *handle)
     {
         return 3;                                                          /* return error */
     }
-    if (handle->timestamp_read == NULL)                                    /* check timestamp_read */
+    if ((handle->timestamp_read == NULL) && 
+        (handle->timestamp_read_us == NULL))                               /* check timestamp_read */
     {
         handle->debug_print("button: timestamp_read is null.\n");          /* timestamp_read is null */
         
@@ -509,24 +1585,56 @@ uint8_t button_init(button_handle_t *handle)
         
         return 3;                                                          /* return error */
     }
+#if (BUTTON_ENABLE_EVENT_QUEUE == 0)
+#if (BUTTON_ENABLE_BATCH == 1)
+    if ((handle->receive_callback == NULL) && 
+        (handle->receive_callback_batch == NULL))                          /* check receive_callback */
+#else
     if (handle->receive_callback == NULL)                                  /* check receive_callback */
+#endif
     {
         handle->debug_print("button: receive_callback is null.\n");        /* receive_callback is null */
         
         return 3;                                                          /* return error */
     }
+#endif
     
-    res = handle->timestamp_read(&t);                                      /* timestamp read */
+    res = a_button_timestamp_read(handle, &t);                             /* timestamp read */
     if (res != 0)                                                          /* check result */
     {
         handle->debug_print("button: timestamp read failed.\n");           /* timestamp read failed */
         
         return 1;                                                          /* return error */
     }
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+    handle->provisional = 0;                                               /* drop the last provisional click */
+#endif
     a_button_reset(handle);                                                /* reset all */
+    handle->last_time = t;                                                 /* init the last time */
     a_button_set_param(handle);                                            /* set params */
-    handle->last_time.s = t.s;                                             /* save last time */
-    handle->last_time.us = t.us;                                           /* save last time */
+#if (BUTTON_ENABLE_CAPTURE == 1)
+    handle->edge_head = 0;                                                 /* init 0 */
+    handle->edge_tail = 0;                                                 /* init 0 */
+    handle->edge_dropped = 0;                                              /* init 0 */
+#endif
+#if (BUTTON_ENABLE_BATCH == 1)
+    handle->batch_len = 0;                                                 /* init 0 */
+#endif
+#if (BUTTON_ENABLE_EVENT_QUEUE == 1)
+    handle->event_head = 0;                                                /* init 0 */
+    handle->event_tail = 0;                                                /* init 0 */
+    handle->event_dropped = 0;                                             /* init 0 */
+    handle->event_dropped_read = 0;                                        /* init 0 */
+#endif
+#if (BUTTON_ENABLE_STATS == 1)
+    memset(&handle->stats, 0, sizeof(button_stats_t));                     /* clear the statistics */
+#endif
+#if (BUTTON_ENABLE_LOG == 1)
+    handle->log_head = 0;                                                  /* init 0 */
+    handle->log_tail = 0;                                                  /* init 0 */
+    handle->log_dropped = 0;                                               /* init 0 */
+    handle->log_dropped_read = 0;                                          /* init 0 */
+#endif
     handle->inited = 1;                                                    /* flag inited */
     
     return 0;                                                              /* success return 0 */
@@ -541,7 +1649,218 @@ uint8_t button_init(button_handle_t *handle)
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t button_deinit(button_handle_t *handle)
+uint8_t button_deinit(button_handle_t *handle)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->inited = 0;             /* flag close */
+    
+    return 0;                       /* success return 0 */
+}
+
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+/**
+ * @brief     set timeout
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t button_set_timeout(button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->timeout = us;           /* set timeout */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get timeout
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t button_get_timeout(button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *us = handle->timeout;          /* get timeout */
+    
+    return 0;                       /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     set interval
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t button_set_interval(button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->interval = us;          /* set interval */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get interval
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t button_get_interval(button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *us = handle->interval;         /* get interval */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     set short time
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t button_set_short_time(button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->short_time = us;        /* set short time */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get short time
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t button_get_short_time(button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *us = handle->short_time;       /* get short time */
+    
+    return 0;                       /* success return 0 */
+}
+
+#if (BUTTON_ENABLE_LONG_PRESS == 1)
+/**
+ * @brief     set long time
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t button_set_long_time(button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->long_time = us;         /* set long time */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get long time
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t button_get_long_time(button_handle_t *handle, uint32_t *us)
 {
     if (handle == NULL)             /* check handle */
     {
@@ -552,13 +1871,15 @@ uint8_t button_deinit(button_handle_t *handle)
         return 3;                   /* return error */
     }
     
-    handle->inited = 0;             /* flag close */
+    *us = handle->long_time;        /* get long time */
     
     return 0;                       /* success return 0 */
 }
+#endif
 
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
 /**
- * @brief     set timeout
+ * @brief     set repeat time
  * @param[in] *handle pointer to a button handle structure
  * @param[in] us set time
  * @return    status code
@@ -567,7 +1888,7 @@ uint8_t button_deinit(button_handle_t *handle)
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t button_set_timeout(button_handle_t *handle, uint32_t us)
+uint8_t button_set_repeat_time(button_handle_t *handle, uint32_t us)
 {
     if (handle == NULL)             /* check handle */
     {
@@ -578,13 +1899,13 @@ uint8_t button_set_timeout(button_handle_t *handle, uint32_t us)
         return 3;                   /* return error */
     }
     
-    handle->timeout = us;           /* set timeout */
+    handle->repeat_time = us;       /* set repeat time */
     
     return 0;                       /* success return 0 */
 }
 
 /**
- * @brief      get timeout
+ * @brief      get repeat time
  * @param[in]  *handle pointer to a button handle structure
  * @param[out] *us pointer to a time buffer
  * @return     status code
@@ -593,7 +1914,7 @@ uint8_t button_set_timeout(button_handle_t *handle, uint32_t us)
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t button_get_timeout(button_handle_t *handle, uint32_t *us)
+uint8_t button_get_repeat_time(button_handle_t *handle, uint32_t *us)
 {
     if (handle == NULL)             /* check handle */
     {
@@ -604,217 +1925,519 @@ uint8_t button_get_timeout(button_handle_t *handle, uint32_t *us)
         return 3;                   /* return error */
     }
     
-    *us = handle->timeout;          /* get timeout */
+    *us = handle->repeat_time;      /* get repeat time */
     
     return 0;                       /* success return 0 */
 }
 
 /**
- * @brief     set interval
+ * @brief     set click mode
  * @param[in] *handle pointer to a button handle structure
- * @param[in] us set time
+ * @param[in] mode click mode
  * @return    status code
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      in the immediate mode a press shorter than the short time is reported as a single click on the release,
+ *            double, triple and repeat clicks are not decoded
+ *            in the speculative mode the single click is reported with the BUTTON_STATUS_FLAG_PROVISIONAL flag on the release,
+ *            then it is reported again with BUTTON_STATUS_FLAG_CONFIRM after the repeat time,
+ *            or the double, triple or repeat click that replaces it is reported with BUTTON_STATUS_FLAG_SUPERSEDES
  */
-uint8_t button_set_interval(button_handle_t *handle, uint32_t us)
+uint8_t button_set_click_mode(button_handle_t *handle, button_click_mode_t mode)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                      /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                            /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                 /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                            /* return error */
     }
     
-    handle->interval = us;          /* set interval */
+    handle->click_mode = (uint8_t)mode;      /* set click mode */
     
-    return 0;                       /* success return 0 */
+    return 0;                                /* success return 0 */
 }
 
 /**
- * @brief      get interval
+ * @brief      get click mode
  * @param[in]  *handle pointer to a button handle structure
- * @param[out] *us pointer to a time buffer
+ * @param[out] *mode pointer to a click mode buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t button_get_interval(button_handle_t *handle, uint32_t *us)
+uint8_t button_get_click_mode(button_handle_t *handle, button_click_mode_t *mode)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                                      /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                            /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                                 /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                            /* return error */
     }
     
-    *us = handle->interval;         /* get interval */
+    *mode = (button_click_mode_t)(handle->click_mode);       /* get click mode */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                /* success return 0 */
 }
+#endif
 
 /**
- * @brief     set short time
- * @param[in] *handle pointer to a button handle structure
- * @param[in] us set time
+ * @brief     initialize the button group
+ * @param[in] *group pointer to a button group structure
  * @return    status code
  *            - 0 success
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ *            - 2 group is NULL
  * @note      none
  */
-uint8_t button_set_short_time(button_handle_t *handle, uint32_t us)
+uint8_t button_group_init(button_group_t *group)
 {
-    if (handle == NULL)             /* check handle */
+    if (group == NULL)                                  /* check group */
+    {
+        return 2;                                       /* return error */
+    }
+    
+    memset(group, 0, sizeof(button_group_t));           /* clear the group */
+    group->inited = 1;                                  /* flag inited */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     close the button group
+ * @param[in] *group pointer to a button group structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ * @note      the added buttons are not closed
+ */
+uint8_t button_group_deinit(button_group_t *group)
+{
+    if (group == NULL)              /* check group */
     {
         return 2;                   /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (group->inited != 1)         /* check group initialization */
     {
         return 3;                   /* return error */
     }
     
-    handle->short_time = us;        /* set short time */
+    group->inited = 0;              /* flag close */
     
     return 0;                       /* success return 0 */
 }
 
 /**
- * @brief      get short time
- * @param[in]  *handle pointer to a button handle structure
- * @param[out] *us pointer to a time buffer
+ * @brief      add a button to the group
+ * @param[in]  *group pointer to a button group structure
+ * @param[in]  *handle pointer to an initialized button handle structure
+ * @param[out] *index pointer to an index buffer
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 2 group is NULL
+ *             - 3 group is not initialized
+ *             - 4 handle is invalid
+ *             - 5 group is full
+ * @note       all buttons in one group must share the same timestamp source,
+ *             the group reads the clock with the first added button
  */
-uint8_t button_get_short_time(button_handle_t *handle, uint32_t *us)
+uint8_t button_group_add(button_group_t *group, button_handle_t *handle, uint16_t *index)
 {
-    if (handle == NULL)             /* check handle */
+    if (group == NULL)                                       /* check group */
     {
-        return 2;                   /* return error */
+        return 2;                                            /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (group->inited != 1)                                  /* check group initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                            /* return error */
+    }
+    if ((handle == NULL) || (handle->inited != 1))           /* check handle */
+    {
+        return 4;                                            /* return error */
+    }
+    if (group->len >= BUTTON_GROUP_LENGTH)                   /* check group length */
+    {
+        handle->debug_print("button: group is full.\n");     /* group is full */
+        
+        return 5;                                            /* return error */
     }
     
-    *us = handle->short_time;       /* get short time */
+    group->handle[group->len] = handle;                      /* save the handle */
+    *index = group->len;                                     /* output the index */
+    group->len++;                                            /* length++ */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                /* success return 0 */
 }
 
 /**
- * @brief     set long time
- * @param[in] *handle pointer to a button handle structure
- * @param[in] us set time
+ * @brief     group irq handler
+ * @param[in] *group pointer to a button group structure
+ * @param[in] index button index
+ * @param[in] press_release press or release
  * @return    status code
  *            - 0 success
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 run failed
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ *            - 7 index is invalid
+ * @note      press is 1
+ *            release is 0
+ *            the decoder result is returned as button_irq_handler_at returns it,
+ *            buttons in a group must get their edges from this function or the group capture handler,
+ *            otherwise the group does not know they are active
  */
-uint8_t button_set_long_time(button_handle_t *handle, uint32_t us)
+uint8_t button_group_irq_handler(button_group_t *group, uint16_t index, uint8_t press_release)
 {
-    if (handle == NULL)             /* check handle */
+    uint8_t res;
+    uint64_t t;
+    
+    if (group == NULL)                                                      /* check group */
     {
-        return 2;                   /* return error */
+        return 2;                                                           /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (group->inited != 1)                                                 /* check group initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                           /* return error */
+    }
+    if (index >= group->len)                                                /* check index */
+    {
+        return 7;                                                           /* return error */
     }
     
-    handle->long_time = us;         /* set long time */
+    res = a_button_timestamp_read(group->handle[0], &t);                    /* timestamp read */
+    if (res != 0)                                                           /* check result */
+    {
+        BUTTON_LOG(group->handle[0], BUTTON_LOG_TIMESTAMP_READ_FAILED, 
+                   group->handle[0]->last_time);                            /* timestamp read failed */
+        
+        return 1;                                                           /* return error */
+    }
     
-    return 0;                       /* success return 0 */
+    return button_group_irq_handler_at(group, index, press_release, t);     /* run the irq handler */
 }
 
 /**
- * @brief      get long time
- * @param[in]  *handle pointer to a button handle structure
- * @param[out] *us pointer to a time buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     group irq handler at a given time
+ * @param[in] *group pointer to a button group structure
+ * @param[in] index button index
+ * @param[in] press_release press or release
+ * @param[in] now timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ *            - 7 index is invalid
+ * @note      press is 1
+ *            release is 0
+ *            now must come from the timestamp source shared by the group,
+ *            the decoder result is returned as button_irq_handler_at returns it
  */
-uint8_t button_get_long_time(button_handle_t *handle, uint32_t *us)
+uint8_t button_group_irq_handler_at(button_group_t *group, uint16_t index, uint8_t press_release, uint64_t now)
 {
-    if (handle == NULL)             /* check handle */
+    uint8_t res;
+    button_handle_t *handle;
+    
+    if (group == NULL)                                                      /* check group */
     {
-        return 2;                   /* return error */
+        return 2;                                                           /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (group->inited != 1)                                                 /* check group initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                           /* return error */
+    }
+    if (index >= group->len)                                                /* check index */
+    {
+        return 7;                                                           /* return error */
     }
     
-    *us = handle->long_time;        /* get long time */
+    handle = group->handle[index];                                          /* get the handle */
+    res = button_irq_handler_at(handle, press_release, now);                /* run the irq handler */
+    if (handle->state != BUTTON_STATE_IDLE)                                 /* if decoding */
+    {
+        BUTTON_ATOMIC_OR(&group->active[index / 32], 
+                         (uint32_t)1 << (index % 32));                      /* set active */
+    }
     
-    return 0;                       /* success return 0 */
+    return res;                                                             /* return the result */
 }
 
 /**
- * @brief     set repeat time
- * @param[in] *handle pointer to a button handle structure
- * @param[in] us set time
+ * @brief     group feed captured edges
+ * @param[in] *group pointer to a button group structure
+ * @param[in] index button index
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
  * @return    status code
  *            - 0 success
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 trigger error
+ *            - 7 index is invalid
+ * @note      the edges are decoded as button_feed_edges decodes them and a button with a pending
+ *            decision is marked active, so the group period handler serves it
  */
-uint8_t button_set_repeat_time(button_handle_t *handle, uint32_t us)
+uint8_t button_group_feed_edges(button_group_t *group, uint16_t index, const button_edge_t *edges, uint16_t len)
 {
-    if (handle == NULL)             /* check handle */
+    uint8_t res;
+    button_handle_t *handle;
+    
+    if (group == NULL)                                                      /* check group */
     {
-        return 2;                   /* return error */
+        return 2;                                                           /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (group->inited != 1)                                                 /* check group initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                           /* return error */
+    }
+    if (index >= group->len)                                                /* check index */
+    {
+        return 7;                                                           /* return error */
     }
     
-    handle->repeat_time = us;       /* set repeat time */
+    handle = group->handle[index];                                          /* get the handle */
+    res = button_feed_edges(handle, edges, len);                            /* decode the edges */
+    if (handle->state != BUTTON_STATE_IDLE)                                 /* if decoding */
+    {
+        BUTTON_ATOMIC_OR(&group->active[index / 32], 
+                         (uint32_t)1 << (index % 32));                      /* set active */
+    }
     
-    return 0;                       /* success return 0 */
+    return res;                                                             /* return the result */
 }
 
+#if (BUTTON_ENABLE_CAPTURE == 1)
 /**
- * @brief      get repeat time
- * @param[in]  *handle pointer to a button handle structure
- * @param[out] *us pointer to a time buffer
+ * @brief     group irq capture handler
+ * @param[in] *group pointer to a button group structure
+ * @param[in] index button index
+ * @param[in] press_release press or release
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 queue is full
+ *            - 7 index is invalid
+ * @note      press is 1
+ *            release is 0
+ *            the edge is queued as button_irq_capture_handler queues it and the button is marked active,
+ *            so the group period handler decodes it
+ */
+uint8_t button_group_irq_capture_handler(button_group_t *group, uint16_t index, uint8_t press_release)
+{
+    uint8_t res;
+    
+    if (group == NULL)                                                      /* check group */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (group->inited != 1)                                                 /* check group initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if (index >= group->len)                                                /* check index */
+    {
+        return 7;                                                           /* return error */
+    }
+    
+    res = button_irq_capture_handler(group->handle[index], press_release);  /* queue the edge */
+    BUTTON_ATOMIC_OR(&group->active[index / 32], 
+                     (uint32_t)1 << (index % 32));                          /* set active */
+    
+    return res;                                                             /* return the result */
+}
+#endif
+
+/**
+ * @brief     group period handler
+ * @param[in] *group pointer to a button group structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 check error
+ * @note      the clock is read once and only the active buttons are processed
+ */
+uint8_t button_group_period_handler(button_group_t *group)
+{
+    uint8_t res;
+    uint16_t i;
+    uint16_t words;
+    uint64_t t;
+    
+    if (group == NULL)                                                            /* check group */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (group->inited != 1)                                                       /* check group initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    words = (group->len + 31) / 32;                                               /* get the bitmap words */
+    for (i = 0; i < words; i++)                                                   /* find the first active word */
+    {
+        if (group->active[i] != 0)                                                /* check the word */
+        {
+            break;                                                                /* break */
+        }
+    }
+    if (i == words)                                                               /* no active button */
+    {
+        return 0;                                                                 /* success return 0 */
+    }
+    
+    res = a_button_timestamp_read(group->handle[0], &t);                          /* read the clock once */
+    if (res != 0)                                                                 /* check result */
+    {
+        BUTTON_LOG(group->handle[0], BUTTON_LOG_TIMESTAMP_READ_FAILED, 
+                   group->handle[0]->last_time);                                  /* timestamp read failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    
+    return button_group_period_handler_at(group, t);                              /* run the period handler */
+}
+
+/**
+ * @brief     group period handler at a given time
+ * @param[in] *group pointer to a button group structure
+ * @param[in] now current timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 check error
+ * @note      now must come from the timestamp source shared by the group,
+ *            only the active buttons are processed,
+ *            an idle button is checked again after its active bit is cleared, so a button pressed or
+ *            captured by an irq between the idle check and the clear is set active again
+ */
+uint8_t button_group_period_handler_at(button_group_t *group, uint64_t now)
+{
+    uint8_t ret;
+    uint16_t i;
+    uint16_t j;
+    uint16_t words;
+    uint32_t bits;
+    button_handle_t *handle;
+    
+    if (group == NULL)                                                            /* check group */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (group->inited != 1)                                                       /* check group initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    ret = 0;                                                                      /* init 0 */
+    words = (group->len + 31) / 32;                                               /* get the bitmap words */
+    for (i = 0; i < words; i++)                                                   /* run all active words */
+    {
+        bits = group->active[i];                                                  /* get the word */
+        for (j = 0; bits != 0; j++)                                               /* run all active bits */
+        {
+            if ((bits & 1) != 0)                                                  /* if active */
+            {
+                handle = group->handle[i * 32 + j];                               /* get the handle */
+                if ((handle->inited == 1) && 
+                    ((handle->state != BUTTON_STATE_IDLE) || 
+                     BUTTON_EDGE_PENDING(handle)))                                /* check the handle */
+                {
+                    if (a_button_period_handler(handle, now) != 0)                /* run the period handler */
+                    {
+                        ret = 4;                                                  /* check error */
+                    }
+                    BUTTON_FLUSH(handle);                                         /* report the batch */
+                }
+                if ((handle->inited != 1) || 
+                    (handle->state == BUTTON_STATE_IDLE))                         /* if idle */
+                {
+                    BUTTON_ATOMIC_AND(&group->active[i], ~((uint32_t)1 << j));    /* clear active before the check again */
+                    if ((handle->inited == 1) && 
+                        ((handle->state != BUTTON_STATE_IDLE) || 
+                         BUTTON_EDGE_PENDING(handle)))                            /* if pressed or captured meanwhile */
+                    {
+                        BUTTON_ATOMIC_OR(&group->active[i], (uint32_t)1 << j);    /* set active again */
+                    }
+                }
+            }
+            bits >>= 1;                                                           /* next bit */
+        }
+    }
+    
+    return ret;                                                                   /* return the result */
+}
+
+/**
+ * @brief      get the next deadline of the group
+ * @param[in]  *group pointer to a button group structure
+ * @param[out] *us pointer to a deadline buffer
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 2 group is NULL
+ *             - 3 group is not initialized
+ * @note       the deadline is the earliest deadline of all active buttons,
+ *             BUTTON_DEADLINE_NEVER means all buttons are idle
  */
-uint8_t button_get_repeat_time(button_handle_t *handle, uint32_t *us)
+uint8_t button_group_get_next_deadline_us(button_group_t *group, uint64_t *us)
 {
-    if (handle == NULL)             /* check handle */
+    uint16_t i;
+    uint16_t j;
+    uint16_t words;
+    uint32_t bits;
+    uint64_t deadline;
+    uint64_t min;
+    button_handle_t *handle;
+    
+    if (group == NULL)                                                    /* check group */
     {
-        return 2;                   /* return error */
+        return 2;                                                         /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (group->inited != 1)                                               /* check group initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                         /* return error */
     }
     
-    *us = handle->repeat_time;      /* get repeat time */
+    min = BUTTON_DEADLINE_NEVER;                                          /* init never */
+    words = (group->len + 31) / 32;                                       /* get the bitmap words */
+    for (i = 0; i < words; i++)                                           /* run all words */
+    {
+        bits = group->active[i];                                          /* get the word */
+        for (j = 0; bits != 0; j++)                                       /* run all active bits */
+        {
+            if ((bits & 1) != 0)                                          /* if active */
+            {
+                handle = group->handle[i * 32 + j];                       /* get the handle */
+                if (handle->inited == 1)                                  /* check the handle */
+                {
+                    deadline = a_button_next_deadline(handle);            /* get the deadline */
+                    if (deadline < min)                                   /* check the min */
+                    {
+                        min = deadline;                                   /* save the min */
+                    }
+                }
+            }
+            bits >>= 1;                                                   /* next bit */
+        }
+    }
+    *us = min;                                                            /* output the deadline */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                             /* success return 0 */
 }
 
 /**
@@ -57,19 +57,168 @@ extern "C"{
  */
 
 /**
- * @brief button length definition
+ * @brief button capture definition
+ * @note  define BUTTON_ENABLE_CAPTURE as 0 to remove the captured edge queue and the capture handlers
  */
-#ifndef BUTTON_LENGTH
-    #define BUTTON_LENGTH      16          /**< 16 */
+#ifndef BUTTON_ENABLE_CAPTURE
+    #define BUTTON_ENABLE_CAPTURE      1   /**< enable */
+#endif
+
+/**
+ * @brief button edge queue length definition
+ * @note  the length must be a power of two
+ */
+#ifndef BUTTON_EDGE_LENGTH
+    #define BUTTON_EDGE_LENGTH      16     /**< 16 */
+#endif
+
+/**
+ * @brief check range
+ */
+#if ((BUTTON_EDGE_LENGTH < 2) || (BUTTON_EDGE_LENGTH > 32768) || \
+     ((BUTTON_EDGE_LENGTH & (BUTTON_EDGE_LENGTH - 1)) != 0))
+    #error "BUTTON_EDGE_LENGTH is invalid"
+#endif
+
+/**
+ * @brief button event queue definition
+ * @note  define BUTTON_ENABLE_EVENT_QUEUE as 0 to remove the event queue and button_read_events,
+ *        then button_init requires a reception callback
+ */
+#ifndef BUTTON_ENABLE_EVENT_QUEUE
+    #define BUTTON_ENABLE_EVENT_QUEUE      1   /**< enable */
+#endif
+
+/**
+ * @brief button event queue length definition
+ * @note  the length must be a power of two
+ */
+#ifndef BUTTON_EVENT_LENGTH
+    #define BUTTON_EVENT_LENGTH      32    /**< 32 */
+#endif
+
+/**
+ * @brief check range
+ */
+#if ((BUTTON_EVENT_LENGTH < 2) || (BUTTON_EVENT_LENGTH > 32768) || \
+     ((BUTTON_EVENT_LENGTH & (BUTTON_EVENT_LENGTH - 1)) != 0))
+    #error "BUTTON_EVENT_LENGTH is invalid"
+#endif
+
+/**
+ * @brief button batch definition
+ * @note  define BUTTON_ENABLE_BATCH as 0 to remove the batch buffer and the batch callback
+ */
+#ifndef BUTTON_ENABLE_BATCH
+    #define BUTTON_ENABLE_BATCH      1     /**< enable */
+#endif
+
+/**
+ * @brief button batch length definition
+ */
+#ifndef BUTTON_BATCH_LENGTH
+    #define BUTTON_BATCH_LENGTH      8     /**< 8 */
+#endif
+
+/**
+ * @brief check range
+ */
+#if ((BUTTON_BATCH_LENGTH < 1) || (BUTTON_BATCH_LENGTH > 65535))
+    #error "BUTTON_BATCH_LENGTH is invalid"
+#endif
+
+/**
+ * @brief button group length definition
+ */
+#ifndef BUTTON_GROUP_LENGTH
+    #define BUTTON_GROUP_LENGTH      64    /**< 64 */
+#endif
+
+/**
+ * @brief check range
+ */
+#if ((BUTTON_GROUP_LENGTH < 1) || (BUTTON_GROUP_LENGTH > 65535))
+    #error "BUTTON_GROUP_LENGTH is invalid"
+#endif
+
+/**
+ * @brief button gesture definition
+ * @note  define a gesture as 0 to remove its decoding, its parameters and its api,
+ *        without any multi click gesture the single click is reported on the release
+ */
+#ifndef BUTTON_ENABLE_DOUBLE_CLICK
+    #define BUTTON_ENABLE_DOUBLE_CLICK      1                           /**< enable */
+#endif
+#ifndef BUTTON_ENABLE_TRIPLE_CLICK
+    #define BUTTON_ENABLE_TRIPLE_CLICK      1                           /**< enable */
+#endif
+#ifndef BUTTON_ENABLE_REPEAT_CLICK
+    #define BUTTON_ENABLE_REPEAT_CLICK      1                           /**< enable */
+#endif
+#ifndef BUTTON_ENABLE_SHORT_PRESS
+    #define BUTTON_ENABLE_SHORT_PRESS       1                           /**< enable */
+#endif
+#ifndef BUTTON_ENABLE_LONG_PRESS
+    #define BUTTON_ENABLE_LONG_PRESS        1                           /**< enable */
+#endif
+#ifndef BUTTON_ENABLE_LONG_HOLD
+    #define BUTTON_ENABLE_LONG_HOLD         BUTTON_ENABLE_LONG_PRESS    /**< follow the long press */
+#endif
+
+/**
+ * @brief check the long hold
+ */
+#if ((BUTTON_ENABLE_LONG_HOLD == 1) && (BUTTON_ENABLE_LONG_PRESS == 0))
+    #error "BUTTON_ENABLE_LONG_HOLD needs BUTTON_ENABLE_LONG_PRESS"
+#endif
+
+/**
+ * @brief button multi click definition
+ */
+#if ((BUTTON_ENABLE_DOUBLE_CLICK == 1) || (BUTTON_ENABLE_TRIPLE_CLICK == 1) || (BUTTON_ENABLE_REPEAT_CLICK == 1))
+    #define BUTTON_ENABLE_MULTI_CLICK       1                           /**< wait for the next click */
+#else
+    #define BUTTON_ENABLE_MULTI_CLICK       0                           /**< report on the release */
+#endif
+
+/**
+ * @brief button statistics definition
+ * @note  define BUTTON_ENABLE_STATS as 1 to count the decoder activity in every handle
+ */
+#ifndef BUTTON_ENABLE_STATS
+    #define BUTTON_ENABLE_STATS      0     /**< disable */
+#endif
+
+/**
+ * @brief button log definition
+ * @note  the decoder diagnostics are queued as binary codes and printed later by button_log_drain,
+ *        define BUTTON_ENABLE_LOG as 0 to remove them
+ */
+#ifndef BUTTON_ENABLE_LOG
+    #define BUTTON_ENABLE_LOG      1       /**< enable */
+#endif
+
+/**
+ * @brief button log length definition
+ * @note  the length must be a power of two
+ */
+#ifndef BUTTON_LOG_LENGTH
+    #define BUTTON_LOG_LENGTH      16      /**< 16 */
 #endif
 
 /**
  * @brief check range
  */
-#if (BUTTON_LENGTH < 8)
-    #error "BUTTON_LENGTH < 8"
+#if ((BUTTON_LOG_LENGTH < 2) || (BUTTON_LOG_LENGTH > 32768) || \
+     ((BUTTON_LOG_LENGTH & (BUTTON_LOG_LENGTH - 1)) != 0))
+    #error "BUTTON_LOG_LENGTH is invalid"
 #endif
 
+/**
+ * @brief button deadline never definition
+ */
+#define BUTTON_DEADLINE_NEVER      0xFFFFFFFFFFFFFFFFULL        /**< no decision is pending */
+
 /**
  * @brief button status enumeration definition
  */
@@ -88,6 +237,62 @@ typedef enum
     BUTTON_STATUS_LONG_PRESS_END    = (1 << 10),       /**< long press end */
 } button_status_t;
 
+/**
+ * @brief button status number definition
+ * @note  one bit of button_status_t per status
+ */
+#define BUTTON_STATUS_NUM    11        /**< status number */
+
+/**
+ * @brief button status flag definition
+ * @note  the flags are or-ed into the status of the clicks in the speculative click mode
+ */
+#define BUTTON_STATUS_FLAG_PROVISIONAL    (1 << 13)        /**< the single click is reported early and may be superseded */
+#define BUTTON_STATUS_FLAG_CONFIRM        (1 << 14)        /**< the provisional single click is confirmed */
+#define BUTTON_STATUS_FLAG_SUPERSEDES     (1 << 15)        /**< the click replaces the provisional single click */
+#define BUTTON_STATUS_FLAG_MASK           (BUTTON_STATUS_FLAG_PROVISIONAL | BUTTON_STATUS_FLAG_CONFIRM | \
+                                           BUTTON_STATUS_FLAG_SUPERSEDES)
+
+/**
+ * @brief button enabled status definition
+ * @note  the statuses the decoder can report with the enabled gestures
+ */
+#define BUTTON_STATUS_ENABLED    (BUTTON_STATUS_PRESS | BUTTON_STATUS_RELEASE | BUTTON_STATUS_SINGLE_CLICK |                  \
+                                  ((BUTTON_ENABLE_DOUBLE_CLICK == 1) ? BUTTON_STATUS_DOUBLE_CLICK : 0) |                        \
+                                  ((BUTTON_ENABLE_TRIPLE_CLICK == 1) ? BUTTON_STATUS_TRIPLE_CLICK : 0) |                        \
+                                  ((BUTTON_ENABLE_REPEAT_CLICK == 1) ? BUTTON_STATUS_REPEAT_CLICK : 0) |                        \
+                                  ((BUTTON_ENABLE_SHORT_PRESS == 1) ?                                                           \
+                                   (BUTTON_STATUS_SHORT_PRESS_START | BUTTON_STATUS_SHORT_PRESS_END) : 0) |                     \
+                                  ((BUTTON_ENABLE_LONG_PRESS == 1) ?                                                            \
+                                   (BUTTON_STATUS_LONG_PRESS_START | BUTTON_STATUS_LONG_PRESS_END) : 0) |                       \
+                                  ((BUTTON_ENABLE_LONG_HOLD == 1) ? BUTTON_STATUS_LONG_PRESS_HOLD : 0))
+
+/**
+ * @brief button state enumeration definition
+ */
+typedef enum
+{
+    BUTTON_STATE_IDLE           = 0x00,        /**< idle */
+    BUTTON_STATE_PRESSED        = 0x01,        /**< pressed */
+    BUTTON_STATE_SHORT_HELD     = 0x02,        /**< short press held */
+    BUTTON_STATE_LONG_HELD      = 0x03,        /**< long press held */
+    BUTTON_STATE_RELEASED_WAIT  = 0x04,        /**< released and waiting for the next click */
+    BUTTON_STATE_SHORT_RELEASED = 0x05,        /**< short press released */
+    BUTTON_STATE_LONG_RELEASED  = 0x06,        /**< long press released */
+    BUTTON_STATE_CLICK_PRESSED  = 0x07,        /**< pressed in a click sequence */
+    BUTTON_STATE_CLICKING       = 0x08,        /**< released in a click sequence */
+} button_state_t;
+
+/**
+ * @brief button click mode enumeration definition
+ */
+typedef enum
+{
+    BUTTON_CLICK_MODE_MULTI       = 0x00,        /**< wait the repeat time for the next click */
+    BUTTON_CLICK_MODE_IMMEDIATE   = 0x01,        /**< report the single click with the release */
+    BUTTON_CLICK_MODE_SPECULATIVE = 0x02,        /**< report a provisional single click with the release */
+} button_click_mode_t;
+
 /**
  * @brief button structure definition
  */
@@ -97,6 +302,59 @@ typedef struct button_s
     uint16_t times;        /**< times */
 } button_t;
 
+/**
+ * @brief button reset cause enumeration definition
+ */
+typedef enum
+{
+    BUTTON_RESET_NOT_MONOTONIC  = 0x00,        /**< timestamp is not monotonic */
+    BUTTON_RESET_TOO_FAST       = 0x01,        /**< edge is rejected by the interval */
+    BUTTON_RESET_DOUBLE_PRESS   = 0x02,        /**< press without release */
+    BUTTON_RESET_DOUBLE_RELEASE = 0x03,        /**< release without press */
+    BUTTON_RESET_CLICK_ERROR    = 0x04,        /**< click gap is over the repeat time */
+    BUTTON_RESET_TIMEOUT        = 0x05,        /**< reset checking after the timeout */
+    BUTTON_RESET_NUM            = 0x06,        /**< reset cause number */
+} button_reset_cause_t;
+
+/**
+ * @brief button log code enumeration definition
+ */
+typedef enum
+{
+    BUTTON_LOG_TIMESTAMP_READ_FAILED = 0x00,        /**< timestamp read failed */
+    BUTTON_LOG_NOT_MONOTONIC         = 0x01,        /**< timestamp is not monotonic */
+    BUTTON_LOG_PRESS_TOO_FAST        = 0x02,        /**< press too fast */
+    BUTTON_LOG_RELEASE_TOO_FAST      = 0x03,        /**< release too fast */
+    BUTTON_LOG_DOUBLE_PRESS          = 0x04,        /**< double press */
+    BUTTON_LOG_DOUBLE_RELEASE        = 0x05,        /**< double release */
+    BUTTON_LOG_DOUBLE_CLICK_ERROR    = 0x06,        /**< double click error */
+    BUTTON_LOG_TRIPLE_CLICK_ERROR    = 0x07,        /**< triple click error */
+    BUTTON_LOG_REPEAT_CLICK_ERROR    = 0x08,        /**< repeat click error */
+    BUTTON_LOG_RESET_CHECKING        = 0x09,        /**< reset checking */
+    BUTTON_LOG_NUM                   = 0x0A,        /**< log code number */
+} button_log_code_t;
+
+/**
+ * @brief button log structure definition
+ */
+typedef struct button_log_s
+{
+    uint64_t t;             /**< timestamp in us */
+    uint8_t code;           /**< log code */
+} button_log_t;
+
+/**
+ * @brief button statistics structure definition
+ */
+typedef struct button_stats_s
+{
+    uint32_t edge_accepted;                     /**< decoded edges */
+    uint32_t edge_rejected;                     /**< edges rejected by the interval */
+    uint32_t reset[BUTTON_RESET_NUM];           /**< error resets, indexed by button_reset_cause_t */
+    uint32_t event[BUTTON_STATUS_NUM];          /**< resolved events, indexed by the bit of button_status_t */
+    uint32_t decode_max;                        /**< max decode depth of one gesture */
+} button_stats_t;
+
 /**
  * @brief button time structure definition
  */
@@ -107,13 +365,13 @@ typedef struct button_time_s
 } button_time_t;
 
 /**
- * @brief button decode structure definition
+ * @brief button edge structure definition
  */
-typedef struct button_decode_s
+typedef struct button_edge_s
 {
-    button_time_t t;        /**< timestamp */
-    uint32_t diff_us;       /**< diff us */
-} button_decode_t;
+    uint64_t t;             /**< timestamp in us */
+    uint8_t level;          /**< press is 1, release is 0 */
+} button_edge_t;
 
 /**
  * @brief button handle structure definition
@@ -121,22 +379,75 @@ typedef struct button_decode_s
 typedef struct button_handle_s
 {
     uint8_t (*timestamp_read)(button_time_t *t);            /**< point to an timestamp_read function address */
+    uint8_t (*timestamp_read_us)(uint64_t *us);             /**< point to a timestamp_read_us function address */
     void (*delay_ms)(uint32_t ms);                          /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);        /**< point to a debug_print function address */
     void (*receive_callback)(button_t *data);               /**< point to a receive_callback function address */
-    button_time_t last_time;                                /**< last time */
-    button_decode_t decode[BUTTON_LENGTH];                  /**< decode buffer */
-    uint16_t decode_len;                                    /**< decode length */
-    uint8_t short_triggered;                                /**< short triggered */
-    uint8_t long_triggered;                                 /**< long triggered */
+#if (BUTTON_ENABLE_BATCH == 1)
+    void (*receive_callback_batch)(button_t *data,
+                                   uint16_t len);           /**< point to a receive_callback_batch function address */
+#endif
+    uint64_t last_time;                                     /**< last time in us */
+    uint64_t press_time;                                    /**< first press of the gesture in us */
+    uint32_t decode_len;                                    /**< accepted edges of the gesture */
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
+    uint8_t click_error;                                    /**< click gap error flag */
+    uint8_t click_mode;                                     /**< click mode */
+    uint8_t provisional;                                    /**< provisional single click flag */
+#endif
+    uint8_t state;                                          /**< decoder state */
+#if (BUTTON_ENABLE_CAPTURE == 1)
+    button_edge_t edge[BUTTON_EDGE_LENGTH];                 /**< captured edge queue */
+    volatile uint16_t edge_head;                            /**< edge queue head, written by the capture handler */
+    volatile uint16_t edge_tail;                            /**< edge queue tail, written by the period handler */
+    uint32_t edge_dropped;                                  /**< dropped edge counter */
+#endif
+#if (BUTTON_ENABLE_BATCH == 1)
+    button_t batch[BUTTON_BATCH_LENGTH];                    /**< pending batch events */
+    uint16_t batch_len;                                     /**< pending batch length */
+#endif
+#if (BUTTON_ENABLE_EVENT_QUEUE == 1)
+    button_t event[BUTTON_EVENT_LENGTH];                    /**< event queue, used when no callback is linked */
+    volatile uint16_t event_head;                           /**< event queue head, written by the decoder */
+    volatile uint16_t event_tail;                           /**< event queue tail, written by button_read_events */
+    volatile uint32_t event_dropped;                        /**< dropped event counter, written by the decoder */
+    uint32_t event_dropped_read;                            /**< dropped event counter seen by button_read_events */
+#endif
+#if (BUTTON_ENABLE_STATS == 1)
+    button_stats_t stats;                                   /**< decoder statistics */
+#endif
+#if (BUTTON_ENABLE_LOG == 1)
+    button_log_t log[BUTTON_LOG_LENGTH];                    /**< log ring */
+    volatile uint16_t log_head;                             /**< log ring head, written by the decoder */
+    volatile uint16_t log_tail;                             /**< log ring tail, written by the log reader */
+    volatile uint32_t log_dropped;                          /**< dropped log counter, written by the decoder */
+    uint32_t log_dropped_read;                              /**< dropped log counter seen by the log reader */
+#endif
     uint8_t inited;                                         /**< inited flag */
     uint32_t short_time;                                    /**< short time */
+#if (BUTTON_ENABLE_LONG_PRESS == 1)
     uint32_t long_time;                                     /**< long time */
+#endif
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
     uint32_t repeat_time;                                   /**< repeat time */
+#endif
     uint32_t interval;                                      /**< interval */
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
     uint32_t timeout;                                       /**< timeout */
+#endif
 } button_handle_t;
 
+/**
+ * @brief button group structure definition
+ */
+typedef struct button_group_s
+{
+    button_handle_t *handle[BUTTON_GROUP_LENGTH];               /**< button handle array */
+    volatile uint32_t active[(BUTTON_GROUP_LENGTH + 31) / 32];  /**< active button bitmap, set by the irq handlers */
+    uint16_t len;                                               /**< button number */
+    uint8_t inited;                                             /**< inited flag */
+} button_group_t;
+
 /**
  * @brief button information structure definition
  */
@@ -180,6 +491,15 @@ typedef struct button_info_s
  */
 #define DRIVER_BUTTON_LINK_TIMESTAMP_READ(HANDLE, FUC)      (HANDLE)->timestamp_read = FUC
 
+/**
+ * @brief     link timestamp_read_us function
+ * @param[in] HANDLE pointer to a button handle structure
+ * @param[in] FUC pointer to a timestamp_read_us function address
+ * @note      the linked function returns one monotonic microsecond count,
+ *            it is used instead of timestamp_read when both are linked
+ */
+#define DRIVER_BUTTON_LINK_TIMESTAMP_READ_US(HANDLE, FUC)   (HANDLE)->timestamp_read_us = FUC
+
 /**
  * @brief     link delay_ms function
  * @param[in] HANDLE pointer to a button handle structure
@@ -200,10 +520,21 @@ typedef struct button_info_s
  * @brief     link receive_callback function
  * @param[in] HANDLE pointer to a button handle structure
  * @param[in] FUC pointer to a receive_callback function address
- * @note      none
+ * @note      if no reception callback is linked, the events are queued for button_read_events
  */
 #define DRIVER_BUTTON_LINK_RECEIVE_CALLBACK(HANDLE, FUC)    (HANDLE)->receive_callback = FUC
 
+#if (BUTTON_ENABLE_BATCH == 1)
+/**
+ * @brief     link receive_callback_batch function
+ * @param[in] HANDLE pointer to a button handle structure
+ * @param[in] FUC pointer to a receive_callback_batch function address
+ * @note      the linked function gets all events decoded in one irq handler or period handler call,
+ *            it is used instead of receive_callback when both are linked
+ */
+#define DRIVER_BUTTON_LINK_RECEIVE_CALLBACK_BATCH(HANDLE, FUC)    (HANDLE)->receive_callback_batch = FUC
+#endif
+
 /**
  * @}
  */
@@ -236,11 +567,67 @@ uint8_t button_info(button_info_t *info);
  *            - 3 handle is not initialized
  *            - 4 trigger error
  *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
  * @note      press is 1
  *            release is 0
  */
 uint8_t button_irq_handler(button_handle_t *handle, uint8_t press_release);
 
+/**
+ * @brief     irq handler at a given time
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] press_release press or release
+ * @param[in] now timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ * @note      press is 1
+ *            release is 0
+ *            now must come from the same clock as the linked timestamp read function,
+ *            the timer decisions due before the edge are run at their deadline first,
+ *            so a late period handler does not change the decoded gesture
+ */
+uint8_t button_irq_handler_at(button_handle_t *handle, uint8_t press_release, uint64_t now);
+
+/**
+ * @brief     feed captured edges
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 trigger error
+ * @note      the edges must be in time order and come from the same clock as the linked timestamp read function,
+ *            every edge is decoded as button_irq_handler_at decodes it,
+ *            the decisions after the last edge are left to the period handler
+ */
+uint8_t button_feed_edges(button_handle_t *handle, const button_edge_t *edges, uint16_t len);
+
+#if (BUTTON_ENABLE_CAPTURE == 1)
+/**
+ * @brief     irq capture handler
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] press_release press or release
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 queue is full
+ * @note      press is 1
+ *            release is 0
+ *            only the timestamp and the level are queued here, the edge is decoded in the period handler,
+ *            this function is the only producer and the period handler is the only consumer of the queue
+ */
+uint8_t button_irq_capture_handler(button_handle_t *handle, uint8_t press_release);
+#endif
+
 /**
  * @brief     period handler
  * @param[in] *handle pointer to a button handle structure
@@ -250,10 +637,140 @@ uint8_t button_irq_handler(button_handle_t *handle, uint8_t press_release);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 check error
- * @note      none
+ * @note      the edges queued by button_irq_capture_handler are decoded first
  */
 uint8_t button_period_handler(button_handle_t *handle);
 
+/**
+ * @brief     period handler at a given time
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] now current timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 check error
+ * @note      now must come from the same clock as the linked timestamp read function,
+ *            the edges queued by button_irq_capture_handler are decoded first
+ */
+uint8_t button_period_handler_at(button_handle_t *handle, uint64_t now);
+
+/**
+ * @brief      get the next deadline
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *us pointer to a deadline buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the deadline is the timestamp in us when the period handler can report the next
+ *             short press, long press, click or timeout decision, BUTTON_DEADLINE_NEVER means idle,
+ *             a captured edge that is not decoded yet is due at its timestamp,
+ *             the deadline can be in the past, then the period handler should run at once,
+ *             long press hold is reported once per period handler call, so the host keeps its
+ *             own hold period while a long press is held
+ */
+uint8_t button_get_next_deadline_us(button_handle_t *handle, uint64_t *us);
+
+/**
+ * @brief      get the decoder state
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       BUTTON_STATE_LONG_HELD tells the host that the deadline is a long press hold
+ */
+uint8_t button_get_state(button_handle_t *handle, button_state_t *state);
+
+#if (BUTTON_ENABLE_EVENT_QUEUE == 1)
+/**
+ * @brief      read the queued events
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *buf pointer to an event buffer
+ * @param[in]  n max event number
+ * @param[out] *len pointer to a read length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 events were dropped since the last read
+ * @note       the events are only queued when no reception callback is linked,
+ *             the queued events are still read when 4 is returned,
+ *             this function is the only consumer of the event queue
+ */
+uint8_t button_read_events(button_handle_t *handle, button_t *buf, uint16_t n, uint16_t *len);
+
+/**
+ * @brief      get the dropped event number
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *dropped pointer to a dropped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the number counts all events dropped since init because the event queue was full
+ */
+uint8_t button_get_event_dropped(button_handle_t *handle, uint32_t *dropped);
+#endif
+
+#if (BUTTON_ENABLE_STATS == 1)
+/**
+ * @brief      get the statistics
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the counters are written by the decoder context without locking,
+ *             read them from the same context for an exact snapshot,
+ *             a provisional single click is not counted, its confirm or superseding click is
+ */
+uint8_t button_get_stats(button_handle_t *handle, button_stats_t *stats);
+
+/**
+ * @brief     reset the statistics
+ * @param[in] *handle pointer to a button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t button_reset_stats(button_handle_t *handle);
+#endif
+
+#if (BUTTON_ENABLE_LOG == 1)
+/**
+ * @brief      read the queued log entries
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *buf pointer to a log buffer
+ * @param[in]  n max entry number
+ * @param[out] *len pointer to a read length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 entries were dropped since the last read
+ * @note       the queued entries are still read when 4 is returned,
+ *             this function and button_log_drain are the only consumers of the log ring
+ */
+uint8_t button_log_read(button_handle_t *handle, button_log_t *buf, uint16_t n, uint16_t *len);
+
+/**
+ * @brief     print the queued log entries
+ * @param[in] *handle pointer to a button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it from a low priority context, the entries are formatted by debug_print
+ */
+uint8_t button_log_drain(button_handle_t *handle);
+#endif
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to a button handle structure
@@ -277,6 +794,7 @@ uint8_t button_init(button_handle_t *handle);
  */
 uint8_t button_deinit(button_handle_t *handle);
 
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
 /**
  * @brief     set timeout
  * @param[in] *handle pointer to a button handle structure
@@ -300,6 +818,7 @@ uint8_t button_set_timeout(button_handle_t *handle, uint32_t us);
  * @note       none
  */
 uint8_t button_get_timeout(button_handle_t *handle, uint32_t *us);
+#endif
 
 /**
  * @brief     set interval
@@ -349,6 +868,7 @@ uint8_t button_set_short_time(button_handle_t *handle, uint32_t us);
  */
 uint8_t button_get_short_time(button_handle_t *handle, uint32_t *us);
 
+#if (BUTTON_ENABLE_LONG_PRESS == 1)
 /**
  * @brief     set long time
  * @param[in] *handle pointer to a button handle structure
@@ -372,7 +892,9 @@ uint8_t button_set_long_time(button_handle_t *handle, uint32_t us);
  * @note       none
  */
 uint8_t button_get_long_time(button_handle_t *handle, uint32_t *us);
+#endif
 
+#if (BUTTON_ENABLE_MULTI_CLICK == 1)
 /**
  * @brief     set repeat time
  * @param[in] *handle pointer to a button handle structure
@@ -397,6 +919,204 @@ uint8_t button_set_repeat_time(button_handle_t *handle, uint32_t us);
  */
 uint8_t button_get_repeat_time(button_handle_t *handle, uint32_t *us);
 
+/**
+ * @brief     set click mode
+ * @param[in] *handle pointer to a button handle structure
+ * @param[in] mode click mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      in the immediate mode a press shorter than the short time is reported as a single click on the release,
+ *            double, triple and repeat clicks are not decoded
+ *            in the speculative mode the single click is reported with the BUTTON_STATUS_FLAG_PROVISIONAL flag on the release,
+ *            then it is reported again with BUTTON_STATUS_FLAG_CONFIRM after the repeat time,
+ *            or the double, triple or repeat click that replaces it is reported with BUTTON_STATUS_FLAG_SUPERSEDES
+ */
+uint8_t button_set_click_mode(button_handle_t *handle, button_click_mode_t mode);
+
+/**
+ * @brief      get click mode
+ * @param[in]  *handle pointer to a button handle structure
+ * @param[out] *mode pointer to a click mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t button_get_click_mode(button_handle_t *handle, button_click_mode_t *mode);
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup button_group_driver button group driver function
+ * @brief    button group driver modules
+ * @ingroup  button_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize the button group
+ * @param[in] *group pointer to a button group structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 group is NULL
+ * @note      none
+ */
+uint8_t button_group_init(button_group_t *group);
+
+/**
+ * @brief     close the button group
+ * @param[in] *group pointer to a button group structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ * @note      the added buttons are not closed
+ */
+uint8_t button_group_deinit(button_group_t *group);
+
+/**
+ * @brief      add a button to the group
+ * @param[in]  *group pointer to a button group structure
+ * @param[in]  *handle pointer to an initialized button handle structure
+ * @param[out] *index pointer to an index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 group is NULL
+ *             - 3 group is not initialized
+ *             - 4 handle is invalid
+ *             - 5 group is full
+ * @note       all buttons in one group must share the same timestamp source,
+ *             the group reads the clock with the first added button
+ */
+uint8_t button_group_add(button_group_t *group, button_handle_t *handle, uint16_t *index);
+
+/**
+ * @brief     group irq handler
+ * @param[in] *group pointer to a button group structure
+ * @param[in] index button index
+ * @param[in] press_release press or release
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ *            - 7 index is invalid
+ * @note      press is 1
+ *            release is 0
+ *            the decoder result is returned as button_irq_handler_at returns it,
+ *            buttons in a group must get their edges from this function or the group capture handler,
+ *            otherwise the group does not know they are active
+ */
+uint8_t button_group_irq_handler(button_group_t *group, uint16_t index, uint8_t press_release);
+
+/**
+ * @brief     group irq handler at a given time
+ * @param[in] *group pointer to a button group structure
+ * @param[in] index button index
+ * @param[in] press_release press or release
+ * @param[in] now timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ *            - 6 timestamp is not monotonic
+ *            - 7 index is invalid
+ * @note      press is 1
+ *            release is 0
+ *            now must come from the timestamp source shared by the group,
+ *            the decoder result is returned as button_irq_handler_at returns it
+ */
+uint8_t button_group_irq_handler_at(button_group_t *group, uint16_t index, uint8_t press_release, uint64_t now);
+
+/**
+ * @brief     group feed captured edges
+ * @param[in] *group pointer to a button group structure
+ * @param[in] index button index
+ * @param[in] *edges pointer to an edge buffer
+ * @param[in] len edge number
+ * @return    status code
+ *            - 0 success
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 trigger error
+ *            - 7 index is invalid
+ * @note      the edges are decoded as button_feed_edges decodes them and a button with a pending
+ *            decision is marked active, so the group period handler serves it
+ */
+uint8_t button_group_feed_edges(button_group_t *group, uint16_t index, const button_edge_t *edges, uint16_t len);
+
+#if (BUTTON_ENABLE_CAPTURE == 1)
+/**
+ * @brief     group irq capture handler
+ * @param[in] *group pointer to a button group structure
+ * @param[in] index button index
+ * @param[in] press_release press or release
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 queue is full
+ *            - 7 index is invalid
+ * @note      press is 1
+ *            release is 0
+ *            the edge is queued as button_irq_capture_handler queues it and the button is marked active,
+ *            so the group period handler decodes it
+ */
+uint8_t button_group_irq_capture_handler(button_group_t *group, uint16_t index, uint8_t press_release);
+#endif
+
+/**
+ * @brief     group period handler
+ * @param[in] *group pointer to a button group structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 check error
+ * @note      the clock is read once and only the active buttons are processed
+ */
+uint8_t button_group_period_handler(button_group_t *group);
+
+/**
+ * @brief     group period handler at a given time
+ * @param[in] *group pointer to a button group structure
+ * @param[in] now current timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 group is NULL
+ *            - 3 group is not initialized
+ *            - 4 check error
+ * @note      now must come from the timestamp source shared by the group,
+ *            only the active buttons are processed
+ */
+uint8_t button_group_period_handler_at(button_group_t *group, uint64_t now);
+
+/**
+ * @brief      get the next deadline of the group
+ * @param[in]  *group pointer to a button group structure
+ * @param[out] *us pointer to a deadline buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 group is NULL
+ *             - 3 group is not initialized
+ * @note       the deadline is the earliest deadline of all active buttons,
+ *             BUTTON_DEADLINE_NEVER means all buttons are idle
+ */
+uint8_t button_group_get_next_deadline_us(button_group_t *group, uint64_t *us);
+
 /**
  * @}
  */
@@ -151,6 +151,27 @@ uint8_t button_trigger_test_irq_handler(uint8_t press_release)
     return 0;
 }
 
+/**
+ * @brief     trigger test irq at a given time
+ * @param[in] press_release press or release
+ * @param[in] us timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      press is 1
+ *            release is 0
+ *            us must come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_trigger_test_irq_handler_at(uint8_t press_release, uint64_t us)
+{
+    if (button_irq_handler_at(&gs_handle, press_release, us) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  trigger test period
  * @return status code
@@ -168,6 +189,40 @@ uint8_t button_trigger_test_period_handler(void)
     return 0;
 }
 
+/**
+ * @brief      trigger test next deadline
+ * @param[out] *us pointer to a deadline buffer
+ * @param[out] *hold pointer to a hold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       BUTTON_DEADLINE_NEVER means idle,
+ *             hold is 1 when a long press is held, then the host runs the period handler at its own hold period
+ */
+uint8_t button_trigger_test_get_next_deadline(uint64_t *us, uint8_t *hold)
+{
+    button_state_t state;
+    
+    if (button_get_next_deadline_us(&gs_handle, us) != 0)
+    {
+        return 1;
+    }
+    if (button_get_state(&gs_handle, &state) != 0)
+    {
+        return 1;
+    }
+    
+    /* the hold deadline stays in the past while the press is held */
+    *hold = 0;
+    if ((state == BUTTON_STATE_LONG_HELD) && (*us != BUTTON_DEADLINE_NEVER))
+    {
+        *us = BUTTON_DEADLINE_NEVER;
+        *hold = 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  trigger test
  * @return status code
@@ -184,6 +239,7 @@ uint8_t button_trigger_test(void)
     /* link interface function */
     DRIVER_BUTTON_LINK_INIT(&gs_handle, button_handle_t);
     DRIVER_BUTTON_LINK_TIMESTAMP_READ(&gs_handle, button_interface_timestamp_read);
+    DRIVER_BUTTON_LINK_TIMESTAMP_READ_US(&gs_handle, button_interface_timestamp_read_us);
     DRIVER_BUTTON_LINK_DELAY_MS(&gs_handle, button_interface_delay_ms);
     DRIVER_BUTTON_LINK_DEBUG_PRINT(&gs_handle, button_interface_debug_print);
     DRIVER_BUTTON_LINK_RECEIVE_CALLBACK(&gs_handle, a_receive_callback);
@@ -232,7 +288,7 @@ uint8_t button_trigger_test(void)
     while (timeout != 0)
     {
         /* check the flag */
-        if ((gs_flag & 0x07FF) == 0x07FF)
+        if ((gs_flag & BUTTON_STATUS_ENABLED) == BUTTON_STATUS_ENABLED)
         {
             break;
         }
@@ -240,6 +296,11 @@ uint8_t button_trigger_test(void)
         /* timeout -- */
         timeout--;
         
+#if (BUTTON_ENABLE_LOG == 1)
+        /* print the decoder log */
+        (void)button_log_drain(&gs_handle);
+#endif
+        
         /* delay 10ms */
         button_interface_delay_ms(10);
     }
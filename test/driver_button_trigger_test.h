@@ -61,6 +61,19 @@ extern "C"{
  */
 uint8_t button_trigger_test_irq_handler(uint8_t press_release);
 
+/**
+ * @brief     trigger test irq at a given time
+ * @param[in] press_release press or release
+ * @param[in] us timestamp of the edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      press is 1
+ *            release is 0
+ *            us must come from the same clock as button_interface_timestamp_read_us
+ */
+uint8_t button_trigger_test_irq_handler_at(uint8_t press_release, uint64_t us);
+
 /**
  * @brief  trigger test period
  * @return status code
@@ -70,6 +83,18 @@ uint8_t button_trigger_test_irq_handler(uint8_t press_release);
  */
 uint8_t button_trigger_test_period_handler(void);
 
+/**
+ * @brief      trigger test next deadline
+ * @param[out] *us pointer to a deadline buffer
+ * @param[out] *hold pointer to a hold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       BUTTON_DEADLINE_NEVER means idle,
+ *             hold is 1 when a long press is held, then the host runs the period handler at its own hold period
+ */
+uint8_t button_trigger_test_get_next_deadline(uint64_t *us, uint8_t *hold);
+
 /**
  * @brief  trigger test
  * @return status code